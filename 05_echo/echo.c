@@ -13,6 +13,7 @@
         #error "BAUD not defined"
 #endif
 
+#include <stddef.h>
 #include <stdint.h>
 #include <avr/io.h>
 #include <util/delay.h>
@@ -26,6 +27,12 @@ void uart_send(const unsigned char data);
 uint8_t uart_recv(struct deque *fifo);
 void trap(const uint8_t err);
 
+#ifdef DEQUE_STATS
+void str_send(const char *str);
+void uint_send(uint16_t n, const uint8_t digits);
+void stats_send(struct deque *fifo);
+#endif
+
 /*******************************************************************************
 * led_init() - configure LED pins
 * @PD4-7: output, drive low
@@ -86,6 +93,8 @@ void uart_send(const unsigned char data)
 #define FIFO_ERROR      (uint8_t) '4'
 #define BAD_BREAK       (uint8_t) '5'
 
+#define STATS_REQUEST   (unsigned char) '?'
+
 uint8_t uart_recv(struct deque *fifo)
 {
         unsigned char data;
@@ -105,11 +114,18 @@ uint8_t uart_recv(struct deque *fifo)
                         return OVERRUN_ERROR;
                 }
 
+                #ifdef DEQUE_STATS
+                        if (data == STATS_REQUEST) {
+                                stats_send(fifo);
+                                continue;
+                        }
+                #endif
+
                 if (deque_push_back(fifo, data)) {
                         return FIFO_ERROR;
                 }
 
-                if (data == (unsigned char) '\n') {
+                if (deque_has_delim(*fifo)) {
                         return RECV_OK;
                 }
 
@@ -137,6 +153,56 @@ void trap(const uint8_t err)
         }
 }
 
+#ifdef DEQUE_STATS
+/*******************************************************************************
+* str_send() - transmit a null terminated string
+*******************************************************************************/
+void str_send(const char *str)
+{
+        while (*str) {
+                uart_send((unsigned char) *str++);
+        }
+}
+
+/*******************************************************************************
+* uint_send() - transmit n in decimal, zero padded to the given digits (max 5)
+*******************************************************************************/
+void uint_send(uint16_t n, const uint8_t digits)
+{
+        char msg[5];
+
+        for (uint8_t i = digits; i > 0; i--) {
+                msg[i - 1] = (char) ('0' + n % 10);
+                n /= 10;
+        }
+
+        for (uint8_t i = 0; i < digits; i++) {
+                uart_send(msg[i]);
+        }
+}
+
+/*******************************************************************************
+* stats_send() - transmit the fifo statistics as one line, used to size
+* BUF_SIZE from measurement. Counting continues afterward.
+*******************************************************************************/
+void stats_send(struct deque *fifo)
+{
+        struct deque_stats stats;
+
+        if (deque_stats_read(fifo, &stats, 0)) {
+                return;
+        }
+
+        str_send("hwm: ");
+        uint_send(stats.hwm, 3);
+        str_send(" full: ");
+        uint_send(stats.full, 5);
+        str_send(" empty: ");
+        uint_send(stats.empty, 5);
+        uart_send('\n');
+}
+#endif
+
 /*******************************************************************************
 * main() - listen on Rx for a newline terminated string of data and then echo
 that data to LEDs and Tx.
@@ -149,6 +215,9 @@ int main(void)
         uart_init();
 
         uint8_t err = 0;
+        uint8_t len = 0;
+        uint8_t line = 0;
+        const unsigned char *span = NULL;
         unsigned char buf[BUF_SIZE] = {0};
         struct deque fifo;
 
@@ -158,6 +227,12 @@ int main(void)
                 trap(err);
         }
 
+        err = deque_set_delim(&fifo, '\n');
+
+        if (err) {
+                trap(err);
+        }
+
         while (1) {
                 err = uart_recv(&fifo);
 
@@ -165,21 +240,40 @@ int main(void)
                         trap(err);
                 }
 
-                unsigned char data = 0;
-                while (deque_is_not_empty(fifo)) {
-                        err = deque_pop_front(&fifo, &data);
+                err = deque_find(&fifo, &line);
+
+                if (err) {
+                        trap(err);
+                }
+
+                //the line, newline included, is read in place in two spans
+                //at most
+                line++;
+
+                while (line) {
+                        err = deque_read_span(&fifo, &span, &len);
 
                         if (err) {
                                 trap(err);
                         }
 
-                        uart_send(data);
-                        led_send(data);
-                        _delay_ms(500);
+                        if (len > line) {
+                                len = line;
+                        }
+
+                        for (uint8_t i = 0; i < len; i++) {
+                                uart_send(span[i]);
+                                led_send(span[i]);
+                                _delay_ms(500);
+                        }
+
+                        err = deque_release(&fifo, len);
 
-                        if (data == (unsigned char) '\n') {
-                                break;
+                        if (err) {
+                                trap(err);
                         }
+
+                        line = (uint8_t) (line - len);
                 }
 
                 led_send(0x00);
@@ -26,17 +26,23 @@ void setup(void) {
 int main(void) {
         setup();
 
+        /* ports B and D each get one register update, so all eight change */
+        /* together */
+        const dio_value toggle[8] = {
+                [0] = {ARDUINO_D04, TOGGLE},
+                [1] = {ARDUINO_D05, TOGGLE},
+                [2] = {ARDUINO_D06, TOGGLE},
+                [3] = {ARDUINO_D07, TOGGLE},
+                [4] = {ARDUINO_D08, TOGGLE},
+                [5] = {ARDUINO_D09, TOGGLE},
+                [6] = {ARDUINO_D10, TOGGLE},
+                [7] = {ARDUINO_D11, TOGGLE},
+        };
+
         while (1) {
                 _delay_ms(1000);
 
-                (void) dio_write(ARDUINO_D04, TOGGLE);
-                (void) dio_write(ARDUINO_D05, TOGGLE);
-                (void) dio_write(ARDUINO_D06, TOGGLE);
-                (void) dio_write(ARDUINO_D07, TOGGLE);
-                (void) dio_write(ARDUINO_D08, TOGGLE);
-                (void) dio_write(ARDUINO_D09, TOGGLE);
-                (void) dio_write(ARDUINO_D10, TOGGLE);
-                (void) dio_write(ARDUINO_D11, TOGGLE);
+                (void) dio_write_many(toggle, 8);
         }
 
         return 0;
@@ -0,0 +1,94 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Single producer multiple reader broadcast ring implementation
+*/
+
+#include "bcast.h"
+#include "ring_sync.h"
+
+/******************************************************************************/
+
+uint8_t bcast_new(struct bcast *b, unsigned char *buf, const uint8_t cap,
+                  volatile uint8_t *tails, const uint8_t nreaders)
+{
+        if (!b || !buf || !tails) {
+                return BCAST_NULL_INPUT;
+        }
+
+        if (cap == 0 || cap > 128 || (cap & (cap - 1))) {
+                return BCAST_CAP_BOUNDS;
+        }
+
+        if (nreaders == 0) {
+                return BCAST_READER_BOUNDS;
+        }
+
+        b->mask = (uint8_t) (cap - 1);
+        b->nreaders = nreaders;
+        b->head = 0;
+        b->tails = tails;
+        b->buf = buf;
+
+        for (uint8_t r = 0; r < nreaders; r++) {
+                tails[r] = 0;
+        }
+
+        return BCAST_SUCCESS;
+}
+
+/*******************************************************************************
+* the producer owns head, so a plain read of it is always current. Every cursor
+* may move concurrently but only toward more free space, so the byte is safe to
+* write once no reader lags by a full ring.
+*/
+
+uint8_t bcast_push(struct bcast *b, const unsigned char data)
+{
+        if (!b) {
+                return BCAST_NULL_INPUT;
+        }
+
+        const uint8_t head = b->head;
+
+        for (uint8_t r = 0; r < b->nreaders; r++) {
+                const uint8_t tail = load_acquire(&b->tails[r]);
+
+                if ((uint8_t) (head - tail) > b->mask) {
+                        return BCAST_FULL;
+                }
+        }
+
+        b->buf[head & b->mask] = data;
+        store_release(&b->head, (uint8_t) (head + 1));
+
+        return BCAST_SUCCESS;
+}
+
+/*******************************************************************************
+* reader r owns tails[r], so a plain read of it is always current. The head may
+* move concurrently but only toward more data.
+*/
+
+uint8_t bcast_pop(struct bcast *b, const uint8_t reader, unsigned char *data)
+{
+        if (!b || !data) {
+                return BCAST_NULL_INPUT;
+        }
+
+        if (reader >= b->nreaders) {
+                return BCAST_READER_BOUNDS;
+        }
+
+        const uint8_t tail = b->tails[reader];
+        const uint8_t head = load_acquire(&b->head);
+
+        if (head == tail) {
+                return BCAST_EMPTY;
+        }
+
+        *data = b->buf[tail & b->mask];
+        store_release(&b->tails[reader], (uint8_t) (tail + 1));
+
+        return BCAST_SUCCESS;
+}
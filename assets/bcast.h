@@ -0,0 +1,100 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Single producer multiple reader broadcast ring for unsigned char data. Every
+* byte pushed by the producer is delivered to every reader, but is stored only
+* once: each reader owns a read cursor into the shared base array and advances
+* it independently. The producer can only overwrite a byte once the slowest
+* reader has consumed it, so free space is capacity minus the largest backlog.
+*
+* Concurrency follows struct spsc: the producer only ever writes the head index
+* and reader r only ever writes its own cursor, so no interrupts are masked. The
+* base array and cursor array are caller-owned and no dynamic allocation is used.
+*
+* usage:
+*       enum {LED, TX, LOG, NREADERS};
+*       static unsigned char buf[64];
+*       static volatile uint8_t cursors[NREADERS];
+*       struct bcast ring;
+*       bcast_new(&ring, buf, 64, cursors, NREADERS);
+*
+*       bcast_push(&ring, UDR0);        //receive ISR
+*       bcast_pop(&ring, TX, &data);    //each consumer with its own id
+*/
+
+#ifndef BCAST_H
+#define BCAST_H
+
+#include <stdint.h>
+
+/*******************************************************************************
+* API error codes
+* @BCAST_CAP_BOUNDS: capacity is not a power of two within 1 to 128
+* @BCAST_NULL_INPUT: input argument is a null pointer
+* @BCAST_FULL: the slowest reader has not made room for another byte
+* @BCAST_EMPTY: the reader has consumed every byte pushed so far
+* @BCAST_READER_BOUNDS: reader id is not below the reader count
+*******************************************************************************/
+#define BCAST_SUCCESS           0
+#define BCAST_CAP_BOUNDS        (uint8_t) '1'
+#define BCAST_NULL_INPUT        (uint8_t) '2'
+#define BCAST_FULL              (uint8_t) '3'
+#define BCAST_EMPTY             (uint8_t) '4'
+#define BCAST_READER_BOUNDS     (uint8_t) '5'
+
+/*******************************************************************************
+* struct bcast
+* @mask: capacity - 1
+* @nreaders: number of read cursors
+* @head: free-running count of pushes, written by the producer only
+* @tails: free-running count of pops per reader, tails[r] written by reader r
+* @buf: base array
+* note: all struct bcast members are READ-ONLY
+* note: as with struct spsc the indices wrap at 256, which is why the capacity
+* is limited to a power of two no larger than 128
+*******************************************************************************/
+struct bcast {
+        uint8_t mask;
+        uint8_t nreaders;
+        volatile uint8_t head;
+        volatile uint8_t *tails;
+        unsigned char *buf;
+};
+
+/*******************************************************************************
+* bcast_new() - initialize broadcast ring
+* @buf: base array
+* @cap: length of base array, a power of two from 1 to 128
+* @tails: cursor array of nreaders entries
+* @nreaders: number of readers, at least 1
+* Returns: error code BCAST_SUCCESS else BCAST_CAP_BOUNDS, BCAST_READER_BOUNDS
+* or BCAST_NULL_INPUT
+* note: call before any context starts using the ring
+*******************************************************************************/
+uint8_t bcast_new(struct bcast *b, unsigned char *buf, const uint8_t cap,
+                  volatile uint8_t *tails, const uint8_t nreaders);
+
+/*******************************************************************************
+* bcast_push() - producer side only
+* Returns: error code BCAST_SUCCESS else BCAST_NULL_INPUT or BCAST_FULL
+* note: costs one cursor load per reader
+*******************************************************************************/
+uint8_t bcast_push(struct bcast *b, const unsigned char data);
+
+/*******************************************************************************
+* bcast_pop() - reader side, each reader id from one context only
+* @reader: reader id, 0 to nreaders - 1
+* Returns: error code BCAST_SUCCESS else BCAST_NULL_INPUT, BCAST_READER_BOUNDS
+* or BCAST_EMPTY
+*******************************************************************************/
+uint8_t bcast_pop(struct bcast *b, const uint8_t reader, unsigned char *data);
+
+/*******************************************************************************
+* helper macros
+* note: macros expect a struct bcast, not a reference to a struct bcast
+* note: the result is a snapshot, see spsc.h
+*******************************************************************************/
+#define bcast_len(b, reader) ((uint8_t) ((b).head - (b).tails[(reader)]))
+#define bcast_is_empty(b, reader) ((b).head == (b).tails[(reader)])
+
+#endif /* BCAST_H */
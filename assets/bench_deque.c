@@ -0,0 +1,225 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Host microbenchmark for struct deque. Each workload mirrors a family of cases
+* in test_deque.c and is timed at every capacity from 1 to 255. Results are
+* written to stdout as CSV, one row per workload and capacity:
+*
+*       workload,capacity,ops,ns_per_op,ops_per_sec
+*
+* usage: ./bench_deque [ops per row]
+*
+* The numbers are for comparing builds of deque.c against each other on the
+* same host, e.g. before and after a change to the wraparound or bulk paths.
+* They say nothing absolute about AVR cycle counts.
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "deque.h"
+
+#define BENCH_OPS_DEFAULT 200000UL
+
+static volatile unsigned char sink;
+
+/*******************************************************************************
+* workloads. Each runs one pass over a deque that is empty on entry and empty on
+* exit, and returns the number of push and pop calls it made.
+*/
+
+//push then immediately pop at the back, see *_lifo_push_then_pop_iteration_back
+static unsigned long lifo_back(struct deque *dq)
+{
+        unsigned char data;
+
+        for (uint8_t i = 0; i < 255; i++) {
+                deque_push_back(dq, i);
+                deque_pop_back(dq, &data);
+                sink ^= data;
+        }
+
+        return 510;
+}
+
+static unsigned long lifo_front(struct deque *dq)
+{
+        unsigned char data;
+
+        for (uint8_t i = 0; i < 255; i++) {
+                deque_push_front(dq, i);
+                deque_pop_front(dq, &data);
+                sink ^= data;
+        }
+
+        return 510;
+}
+
+//fill at one end then drain from the other, see *_push_back_then_pop_front
+static unsigned long fifo_back(struct deque *dq)
+{
+        unsigned char data;
+        const uint8_t cap = dq->cap;
+
+        for (uint8_t i = 0; i < cap; i++) {
+                deque_push_back(dq, i);
+        }
+
+        for (uint8_t i = 0; i < cap; i++) {
+                deque_pop_front(dq, &data);
+                sink ^= data;
+        }
+
+        return 2UL * cap;
+}
+
+static unsigned long fifo_front(struct deque *dq)
+{
+        unsigned char data;
+        const uint8_t cap = dq->cap;
+
+        for (uint8_t i = 0; i < cap; i++) {
+                deque_push_front(dq, i);
+        }
+
+        for (uint8_t i = 0; i < cap; i++) {
+                deque_pop_back(dq, &data);
+                sink ^= data;
+        }
+
+        return 2UL * cap;
+}
+
+//steady state stream that walks the indices across the wrap, see test_mixed_*
+static unsigned long mixed_back(struct deque *dq)
+{
+        unsigned char data;
+
+        for (uint8_t i = 0; i < 255; i++) {
+                deque_push_back(dq, i);
+                deque_pop_front(dq, &data);
+                sink ^= data;
+        }
+
+        return 510;
+}
+
+static unsigned long mixed_front(struct deque *dq)
+{
+        unsigned char data;
+
+        for (uint8_t i = 0; i < 255; i++) {
+                deque_push_front(dq, i);
+                deque_pop_back(dq, &data);
+                sink ^= data;
+        }
+
+        return 510;
+}
+
+//fill to capacity then purge from the same end, see *_fill_completely_then_*
+static unsigned long fill_purge_back(struct deque *dq)
+{
+        unsigned char data;
+        const uint8_t cap = dq->cap;
+
+        for (uint8_t i = 0; i < cap; i++) {
+                deque_push_back(dq, i);
+        }
+
+        for (uint8_t i = 0; i < cap; i++) {
+                deque_pop_back(dq, &data);
+                sink ^= data;
+        }
+
+        return 2UL * cap;
+}
+
+static unsigned long fill_purge_front(struct deque *dq)
+{
+        unsigned char data;
+        const uint8_t cap = dq->cap;
+
+        for (uint8_t i = 0; i < cap; i++) {
+                deque_push_front(dq, i);
+        }
+
+        for (uint8_t i = 0; i < cap; i++) {
+                deque_pop_front(dq, &data);
+                sink ^= data;
+        }
+
+        return 2UL * cap;
+}
+
+/******************************************************************************/
+
+static const struct {
+        const char *name;
+        unsigned long (*run)(struct deque *dq);
+} workloads[] = {
+        {"lifo_back", lifo_back},
+        {"lifo_front", lifo_front},
+        {"fifo_back", fifo_back},
+        {"fifo_front", fifo_front},
+        {"mixed_back", mixed_back},
+        {"mixed_front", mixed_front},
+        {"fill_purge_back", fill_purge_back},
+        {"fill_purge_front", fill_purge_front},
+};
+
+static double elapsed_ns(const struct timespec *start,
+                         const struct timespec *stop)
+{
+        return (double) (stop->tv_sec - start->tv_sec) * 1e9
+                + (double) (stop->tv_nsec - start->tv_nsec);
+}
+
+int main(int argc, char **argv)
+{
+        unsigned long target = BENCH_OPS_DEFAULT;
+        unsigned char buf[255];
+        struct deque dq;
+        struct timespec start;
+        struct timespec stop;
+
+        if (argc > 1) {
+                target = strtoul(argv[1], NULL, 10);
+
+                if (target == 0) {
+                        fprintf(stderr, "usage: %s [ops per row]\n", argv[0]);
+                        return EXIT_FAILURE;
+                }
+        }
+
+        printf("workload,capacity,ops,ns_per_op,ops_per_sec\n");
+
+        for (size_t w = 0; w < sizeof(workloads) / sizeof(workloads[0]); w++) {
+                for (uint16_t cap = 1; cap <= 255; cap++) {
+                        unsigned long ops = 0;
+
+                        deque_new(&dq, buf, (uint8_t) cap);
+
+                        //warm up the cache and branch predictors
+                        workloads[w].run(&dq);
+
+                        clock_gettime(CLOCK_MONOTONIC, &start);
+
+                        while (ops < target) {
+                                ops += workloads[w].run(&dq);
+                        }
+
+                        clock_gettime(CLOCK_MONOTONIC, &stop);
+
+                        const double ns = elapsed_ns(&start, &stop);
+
+                        printf("%s,%u,%lu,%.3f,%.0f\n", workloads[w].name,
+                               (unsigned) cap, ops, ns / (double) ops,
+                               (double) ops * 1e9 / ns);
+                }
+        }
+
+        return EXIT_SUCCESS;
+}
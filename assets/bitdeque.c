@@ -0,0 +1,244 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Double ended queue for single bit data implementation
+*/
+
+#include <string.h>
+
+#include "bitdeque.h"
+
+/*******************************************************************************
+* bit index wraparound. The capacity is a multiple of 8 but not necessarily a
+* power of two, so wrap with a compare instead of a mask.
+*/
+
+static inline uint16_t bitdeque_next(const struct bitdeque *bq,
+                                     const uint16_t i)
+{
+        return (uint16_t) (i + 1 == bq->cap ? 0 : i + 1);
+}
+
+static inline uint16_t bitdeque_prev(const struct bitdeque *bq,
+                                     const uint16_t i)
+{
+        return (uint16_t) (i ? i - 1 : bq->cap - 1);
+}
+
+/*******************************************************************************
+* multi-position advance for the bulk operations, both i and n are at most cap
+*/
+
+static inline uint16_t bitdeque_add(const struct bitdeque *bq,
+                                    const uint16_t i, const uint16_t n)
+{
+        const uint16_t j = (uint16_t) (i + n);
+
+        return (uint16_t) (j >= bq->cap ? j - bq->cap : j);
+}
+
+/*******************************************************************************
+* bit i lives at bit i % 8 of byte i / 8
+*/
+
+static inline uint8_t bitdeque_get(const struct bitdeque *bq, const uint16_t i)
+{
+        return (uint8_t) ((bq->buf[i >> 3] >> (i & 7)) & 1);
+}
+
+static inline void bitdeque_set(struct bitdeque *bq, const uint16_t i,
+                                const uint8_t bit)
+{
+        const uint8_t mask = (uint8_t) (1 << (i & 7));
+
+        if (bit) {
+                bq->buf[i >> 3] |= mask;
+        } else {
+                bq->buf[i >> 3] &= (uint8_t) ~mask;
+        }
+}
+
+/******************************************************************************/
+
+uint8_t bitdeque_new(struct bitdeque *bq, unsigned char *buf,
+                     const uint8_t nbytes)
+{
+        if (deque_is_null(bq) || deque_is_null(buf)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (nbytes == 0) {
+                return DEQUE_CAP_BOUNDS;
+        }
+
+        bq->cap = (uint16_t) (nbytes * 8);
+        bq->len = 0;
+        bq->front = 0;
+        bq->back = 0;
+        bq->buf = buf;
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t bitdeque_push_back(struct bitdeque *bq, const uint8_t bit)
+{
+        if (deque_is_null(bq)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (bitdeque_is_full(*bq)) {
+                return DEQUE_FULL;
+        }
+
+        bitdeque_set(bq, bq->back, bit);
+        bq->back = bitdeque_next(bq, bq->back);
+        bq->len++;
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t bitdeque_pop_back(struct bitdeque *bq, uint8_t *bit)
+{
+        if (deque_is_null(bq) || deque_is_null(bit)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (bitdeque_is_empty(*bq)) {
+                return DEQUE_EMPTY;
+        }
+
+        bq->back = bitdeque_prev(bq, bq->back);
+        *bit = bitdeque_get(bq, bq->back);
+        bq->len--;
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t bitdeque_push_front(struct bitdeque *bq, const uint8_t bit)
+{
+        if (deque_is_null(bq)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (bitdeque_is_full(*bq)) {
+                return DEQUE_FULL;
+        }
+
+        bq->front = bitdeque_prev(bq, bq->front);
+        bitdeque_set(bq, bq->front, bit);
+        bq->len++;
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t bitdeque_pop_front(struct bitdeque *bq, uint8_t *bit)
+{
+        if (deque_is_null(bq) || deque_is_null(bit)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (bitdeque_is_empty(*bq)) {
+                return DEQUE_EMPTY;
+        }
+
+        *bit = bitdeque_get(bq, bq->front);
+        bq->front = bitdeque_next(bq, bq->front);
+        bq->len--;
+
+        return DEQUE_SUCCESS;
+}
+
+/*******************************************************************************
+* on a byte boundary the bits of src already have the packed layout, so the
+* block goes in with at most two memcpy calls like deque_push_back_n(). The
+* capacity is a multiple of 8, so an aligned index stays aligned after a wrap.
+*/
+
+uint8_t bitdeque_push_back_n(struct bitdeque *bq, const unsigned char *src,
+                             const uint8_t n)
+{
+        if (deque_is_null(bq) || deque_is_null(src)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        const uint16_t nbits = (uint16_t) (n * 8);
+
+        if (nbits > bq->cap - bq->len) {
+                return DEQUE_FULL;
+        }
+
+        if ((bq->back & 7) == 0) {
+                const uint8_t i = (uint8_t) (bq->back >> 3);
+                const uint8_t head = (uint8_t) ((bq->cap >> 3) - i);
+
+                if (n <= head) {
+                        memcpy(bq->buf + i, src, n);
+                } else {
+                        memcpy(bq->buf + i, src, head);
+                        memcpy(bq->buf, src + head, (size_t) (n - head));
+                }
+
+                bq->back = bitdeque_add(bq, bq->back, nbits);
+        } else {
+                for (uint16_t k = 0; k < nbits; k++) {
+                        const uint8_t bit = (uint8_t) (src[k >> 3] >> (k & 7));
+
+                        bitdeque_set(bq, bq->back, bit & 1);
+                        bq->back = bitdeque_next(bq, bq->back);
+                }
+        }
+
+        bq->len = (uint16_t) (bq->len + nbits);
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t bitdeque_pop_front_n(struct bitdeque *bq, unsigned char *dst,
+                             const uint8_t n)
+{
+        if (deque_is_null(bq) || deque_is_null(dst)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        const uint16_t nbits = (uint16_t) (n * 8);
+
+        if (nbits > bq->len) {
+                return DEQUE_EMPTY;
+        }
+
+        if ((bq->front & 7) == 0) {
+                const uint8_t i = (uint8_t) (bq->front >> 3);
+                const uint8_t head = (uint8_t) ((bq->cap >> 3) - i);
+
+                if (n <= head) {
+                        memcpy(dst, bq->buf + i, n);
+                } else {
+                        memcpy(dst, bq->buf + i, head);
+                        memcpy(dst + head, bq->buf, (size_t) (n - head));
+                }
+
+                bq->front = bitdeque_add(bq, bq->front, nbits);
+        } else {
+                memset(dst, 0, n);
+
+                for (uint16_t k = 0; k < nbits; k++) {
+                        dst[k >> 3] |= (uint8_t) (bitdeque_get(bq, bq->front)
+                                                  << (k & 7));
+                        bq->front = bitdeque_next(bq, bq->front);
+                }
+        }
+
+        bq->len = (uint16_t) (bq->len - nbits);
+
+        return DEQUE_SUCCESS;
+}
@@ -0,0 +1,83 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Double ended queue for single bit data. Eight elements are packed into each
+* byte of the base array, so a stream of one bit symbols (morse timings, button
+* edges, sampled pin states) gets eight times the capacity of a struct deque in
+* the same SRAM. Bits are stored least significant first within each byte. The
+* error codes and build profile (DEQUE_UNCHECKED) are shared with deque.h.
+*/
+
+#ifndef BITDEQUE_H
+#define BITDEQUE_H
+
+#include <stdint.h>
+
+#include "deque.h"
+
+/*******************************************************************************
+* struct bitdeque
+* @cap: maximum capacity in bits, always a multiple of 8
+* @len: current size in bits
+* @front: bit index of front element
+* @back: bit index of back element
+* @buf: base array
+* note: all struct bitdeque members are READ-ONLY
+*******************************************************************************/
+struct bitdeque {
+        uint16_t cap;
+        uint16_t len;
+        uint16_t front;
+        uint16_t back;
+        unsigned char *buf;
+};
+
+/*******************************************************************************
+* bitdeque_new() - initialize bit deque
+* @buf: base array
+* @nbytes: length of base array in bytes, the capacity is 8 * nbytes bits
+* Returns: error code DEQUE_SUCCESS else DEQUE_CAP_BOUNDS or DEQUE_NULL_INPUT
+*******************************************************************************/
+uint8_t bitdeque_new(struct bitdeque *bq, unsigned char *buf,
+                     const uint8_t nbytes);
+
+/*******************************************************************************
+* single bit operations
+* note: any nonzero bit argument is pushed as 1, popped bits are 0 or 1
+*******************************************************************************/
+uint8_t bitdeque_push_back(struct bitdeque *bq, const uint8_t bit);
+uint8_t bitdeque_pop_back(struct bitdeque *bq, uint8_t *bit);
+uint8_t bitdeque_push_front(struct bitdeque *bq, const uint8_t bit);
+uint8_t bitdeque_pop_front(struct bitdeque *bq, uint8_t *bit);
+
+/*******************************************************************************
+* bitdeque_push_back_n() - push n bytes worth of bits onto the back
+* @src: block of n bytes, bit 0 of src[0] is pushed first
+* Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT or DEQUE_FULL
+* note: the block is pushed entirely or not at all. When the back index is on a
+* byte boundary the block is copied whole, otherwise bit by bit.
+*******************************************************************************/
+uint8_t bitdeque_push_back_n(struct bitdeque *bq, const unsigned char *src,
+                             const uint8_t n);
+
+/*******************************************************************************
+* bitdeque_pop_front_n() - pop n bytes worth of bits off the front
+* @dst: block of n bytes, the front bit is written to bit 0 of dst[0]
+* Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT or DEQUE_EMPTY
+* note: the block is popped entirely or not at all. When the front index is on
+* a byte boundary the block is copied whole, otherwise bit by bit.
+*******************************************************************************/
+uint8_t bitdeque_pop_front_n(struct bitdeque *bq, unsigned char *dst,
+                             const uint8_t n);
+
+/*******************************************************************************
+* helper macros
+* note: macros expect a struct bitdeque, not a reference to a struct bitdeque
+*******************************************************************************/
+#define bitdeque_is_full(bq) ((bq).cap == (bq).len)
+#define bitdeque_is_not_full(bq) (!((bq).cap == (bq).len))
+
+#define bitdeque_is_empty(bq) ((bq).len == 0)
+#define bitdeque_is_not_empty(bq) (!((bq).len == 0))
+
+#endif /* BITDEQUE_H */
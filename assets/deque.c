@@ -4,12 +4,161 @@
 * Double ended queue implementation
 */
 
+#include <string.h>
+
 #include "deque.h"
+#include "deque_ops.h"
+
+/*******************************************************************************
+* the statistics block is read and reset with interrupts disabled on AVR, since
+* its multi-byte counters may be updated by an ISR midway through a copy
+*/
+
+#ifdef atomic
+        #error "deque.c internal bug: atomic definition exists"
+#elif defined(DEQUE_STATS) && defined(__AVR__)
+        #include <util/atomic.h>
+        #define atomic ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+#else
+        #define atomic
+#endif
+
+/*******************************************************************************
+* multi-position index arithmetic for the bulk operations. Both i and n are at
+* most cap so a single conditional subtraction or addition suffices.
+*/
+
+static inline uint8_t deque_add(const struct deque *dq, const uint8_t i,
+                                const uint8_t n)
+{
+        uint16_t j = (uint16_t) (i + n);
+
+        if (j >= dq->cap) {
+                j = (uint16_t) (j - dq->cap);
+        }
+
+        return (uint8_t) j;
+}
+
+static inline uint8_t deque_sub(const struct deque *dq, const uint8_t i,
+                                const uint8_t n)
+{
+        if (i >= n) {
+                return (uint8_t) (i - n);
+        }
+
+        return (uint8_t) (i + dq->cap - n);
+}
+
+/*******************************************************************************
+* copy a block into or out of the base array starting at index i. The block is
+* split into at most two contiguous segments at the end of the base array.
+*/
+
+static void deque_copy_in(struct deque *dq, const uint8_t i,
+                          const unsigned char *src, const uint8_t n)
+{
+        const uint8_t head = (uint8_t) (dq->cap - i);
+
+        if (n <= head) {
+                memcpy(dq->buf + i, src, n);
+        } else {
+                memcpy(dq->buf + i, src, head);
+                memcpy(dq->buf, src + head, (size_t) (n - head));
+        }
+}
+
+static void deque_copy_out(const struct deque *dq, const uint8_t i,
+                           unsigned char *dst, const uint8_t n)
+{
+        const uint8_t head = (uint8_t) (dq->cap - i);
+
+        if (n <= head) {
+                memcpy(dst, dq->buf + i, n);
+        } else {
+                memcpy(dst, dq->buf + i, head);
+                memcpy(dst + head, dq->buf, (size_t) (n - head));
+        }
+}
+
+/*******************************************************************************
+* reverse the n bytes starting at buf[i], used for the in-place rotation
+*/
+
+static void deque_reverse(unsigned char *buf, uint8_t i, const uint8_t n)
+{
+        if (n < 2) {
+                return;
+        }
+
+        uint8_t j = (uint8_t) (i + n - 1);
+
+        while (i < j) {
+                const unsigned char tmp = buf[i];
+                buf[i++] = buf[j];
+                buf[j--] = tmp;
+        }
+}
+
+/*******************************************************************************
+* count the delimiters within the n elements starting at index i
+*/
+
+static uint8_t deque_count(const struct deque *dq, uint8_t i, uint8_t n)
+{
+        uint8_t count = 0;
+
+        while (n--) {
+                if (dq->buf[i] == dq->delim) {
+                        count++;
+                }
+
+                i = (uint8_t) (i + 1 == dq->cap ? 0 : i + 1);
+        }
+
+        return count;
+}
+
+static inline void deque_track_block_in(struct deque *dq, const uint8_t i,
+                                        const uint8_t n)
+{
+        if (dq->flags & DEQUE_TRACK_DELIM) {
+                dq->ndelim = (uint8_t) (dq->ndelim + deque_count(dq, i, n));
+        }
+}
+
+static inline void deque_track_block_out(struct deque *dq, const uint8_t i,
+                                         const uint8_t n)
+{
+        if (dq->flags & DEQUE_TRACK_DELIM) {
+                dq->ndelim = (uint8_t) (dq->ndelim - deque_count(dq, i, n));
+        }
+}
+
+/*******************************************************************************
+* overwrite mode eviction of k elements to make room for a bulk push
+*/
+
+static void deque_drop_front(struct deque *dq, const uint8_t k)
+{
+        deque_track_block_out(dq, dq->front, k);
+        dq->front = deque_add(dq, dq->front, k);
+        dq->len = (uint8_t) (dq->len - k);
+        deque_count_overwrites(dq, k);
+}
+
+static void deque_drop_back(struct deque *dq, const uint8_t k)
+{
+        dq->back = deque_sub(dq, dq->back, k);
+        deque_track_block_out(dq, dq->back, k);
+        dq->len = (uint8_t) (dq->len - k);
+        deque_count_overwrites(dq, k);
+}
 
 /******************************************************************************/
 
 uint8_t deque_new(struct deque *dq, unsigned char *buf, const uint8_t cap) {
-        if (!buf) {
+        if (deque_is_null(buf)) {
                 return DEQUE_NULL_INPUT;
         }
 
@@ -21,88 +170,400 @@ uint8_t deque_new(struct deque *dq, unsigned char *buf, const uint8_t cap) {
         dq->len = 0;
         dq->front = 0;
         dq->back = 0;
+        dq->mask = (cap & (cap - 1)) ? 0 : (uint8_t) (cap - 1);
+        dq->flags = 0;
+        dq->delim = 0;
+        dq->ndelim = 0;
+        dq->overwrites = 0;
         dq->buf = buf;
 
+        #ifdef DEQUE_STATS
+                dq->stats = (struct deque_stats) {0};
+        #endif
+
+        #ifdef DEQUE_WATERMARK
+                dq->low = 0;
+                dq->high = 0;
+                dq->on_low = NULL;
+                dq->on_high = NULL;
+        #endif
+
         return DEQUE_SUCCESS;
 }
 
 /*******************************************************************************
-* place data then increment index
+* bulk operations. Each validates once, copies at most two segments, and then
+* updates the index and length once for the whole block.
 */
 
-uint8_t deque_push_back(struct deque *dq, const unsigned char data) {
-        if (!dq) {
+uint8_t deque_push_back_n(struct deque *dq, const unsigned char *src,
+                          uint8_t n)
+{
+        if (deque_is_null(dq) || deque_is_null(src)) {
                 return DEQUE_NULL_INPUT;
         }
 
-        if (deque_is_full(*dq)) {
-                return DEQUE_FULL;
+        if (n > dq->cap - dq->len) {
+                if (!(dq->flags & DEQUE_OVERWRITE)) {
+                        deque_stats_full(dq);
+                        return DEQUE_FULL;
+                }
+
+                if (n > dq->cap) {
+                        deque_count_overwrites(dq, (uint8_t) (n - dq->cap));
+                        src += n - dq->cap;
+                        n = dq->cap;
+                }
+
+                deque_drop_front(dq, (uint8_t) (n - (dq->cap - dq->len)));
         }
 
-        dq->buf[dq->back] = data;
-        dq->back = (uint8_t) ((dq->back + 1) % dq->cap);
-        dq->len++;
+        deque_copy_in(dq, dq->back, src, n);
+        deque_track_block_in(dq, dq->back, n);
+        dq->back = deque_add(dq, dq->back, n);
+        dq->len = (uint8_t) (dq->len + n);
+        deque_stats_in(dq, n);
+        deque_watermark(dq);
 
         return DEQUE_SUCCESS;
 }
 
-/******************************************************************************
-* decrement index then get data
-*/
+/******************************************************************************/
 
-uint8_t deque_pop_back(struct deque *dq, unsigned char *data) {
-        if (!dq || !data) {
+uint8_t deque_pop_back_n(struct deque *dq, unsigned char *dst, const uint8_t n)
+{
+        if (deque_is_null(dq) || deque_is_null(dst)) {
                 return DEQUE_NULL_INPUT;
         }
 
-        if (deque_is_empty(*dq)) {
+        if (n > dq->len) {
+                deque_stats_empty(dq);
                 return DEQUE_EMPTY;
         }
 
-        dq->back = (uint8_t) ((dq->back + dq->cap - 1) % dq->cap);
-        *data = dq->buf[dq->back];
-        dq->len--;
+        dq->back = deque_sub(dq, dq->back, n);
+        deque_copy_out(dq, dq->back, dst, n);
+        deque_track_block_out(dq, dq->back, n);
+        dq->len = (uint8_t) (dq->len - n);
+        deque_watermark(dq);
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t deque_push_front_n(struct deque *dq, const unsigned char *src,
+                           uint8_t n)
+{
+        if (deque_is_null(dq) || deque_is_null(src)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (n > dq->cap - dq->len) {
+                if (!(dq->flags & DEQUE_OVERWRITE)) {
+                        deque_stats_full(dq);
+                        return DEQUE_FULL;
+                }
+
+                if (n > dq->cap) {
+                        deque_count_overwrites(dq, (uint8_t) (n - dq->cap));
+                        n = dq->cap;
+                }
+
+                deque_drop_back(dq, (uint8_t) (n - (dq->cap - dq->len)));
+        }
+
+        dq->front = deque_sub(dq, dq->front, n);
+        deque_copy_in(dq, dq->front, src, n);
+        deque_track_block_in(dq, dq->front, n);
+        dq->len = (uint8_t) (dq->len + n);
+        deque_stats_in(dq, n);
+        deque_watermark(dq);
 
         return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t deque_pop_front_n(struct deque *dq, unsigned char *dst,
+                          const uint8_t n)
+{
+        if (deque_is_null(dq) || deque_is_null(dst)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (n > dq->len) {
+                deque_stats_empty(dq);
+                return DEQUE_EMPTY;
+        }
+
+        deque_copy_out(dq, dq->front, dst, n);
+        deque_track_block_out(dq, dq->front, n);
+        dq->front = deque_add(dq, dq->front, n);
+        dq->len = (uint8_t) (dq->len - n);
+        deque_watermark(dq);
 
+        return DEQUE_SUCCESS;
 }
 
-/******************************************************************************
-* decrement index then place data
+/*******************************************************************************
+* span operations. The free region at the back is bounded by the end of the
+* base array and by the total free space, whichever comes first. Likewise for
+* the occupied region at the front.
 */
 
-uint8_t deque_push_front(struct deque *dq, const unsigned char data) {
-        if (!dq) {
+uint8_t deque_write_span(struct deque *dq, unsigned char **span, uint8_t *n)
+{
+        if (deque_is_null(dq) || deque_is_null(span) || deque_is_null(n)) {
                 return DEQUE_NULL_INPUT;
         }
 
         if (deque_is_full(*dq)) {
+                *n = 0;
                 return DEQUE_FULL;
         }
 
-        dq->front = (uint8_t) ((dq->front + dq->cap - 1) % dq->cap);
-        dq->buf[dq->front] = data;
-        dq->len++;
+        const uint8_t avail = (uint8_t) (dq->cap - dq->len);
+        const uint8_t head = (uint8_t) (dq->cap - dq->back);
+
+        *span = dq->buf + dq->back;
+        *n = avail < head ? avail : head;
 
         return DEQUE_SUCCESS;
 }
 
-/******************************************************************************
-* get data then increment index
-*/
+/******************************************************************************/
+
+uint8_t deque_commit(struct deque *dq, const uint8_t n)
+{
+        if (deque_is_null(dq)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (n > dq->cap - dq->len) {
+                deque_stats_full(dq);
+                return DEQUE_FULL;
+        }
+
+        deque_track_block_in(dq, dq->back, n);
+        dq->back = deque_add(dq, dq->back, n);
+        dq->len = (uint8_t) (dq->len + n);
+        deque_stats_in(dq, n);
+        deque_watermark(dq);
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
 
-uint8_t deque_pop_front(struct deque *dq, unsigned char *data) {
-        if (!dq || !data) {
+uint8_t deque_read_span(const struct deque *dq, const unsigned char **span,
+                        uint8_t *n)
+{
+        if (deque_is_null(dq) || deque_is_null(span) || deque_is_null(n)) {
                 return DEQUE_NULL_INPUT;
         }
 
         if (deque_is_empty(*dq)) {
+                *n = 0;
+                return DEQUE_EMPTY;
+        }
+
+        const uint8_t head = (uint8_t) (dq->cap - dq->front);
+
+        *span = dq->buf + dq->front;
+        *n = dq->len < head ? dq->len : head;
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t deque_release(struct deque *dq, const uint8_t n)
+{
+        if (deque_is_null(dq)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (n > dq->len) {
+                deque_stats_empty(dq);
                 return DEQUE_EMPTY;
         }
 
-        *data = dq->buf[dq->front];
-        dq->front = (uint8_t) ((dq->front + 1) % dq->cap);
-        dq->len--;
+        deque_track_block_out(dq, dq->front, n);
+        dq->front = deque_add(dq, dq->front, n);
+        dq->len = (uint8_t) (dq->len - n);
+        deque_watermark(dq);
+
+        return DEQUE_SUCCESS;
+}
+
+/*******************************************************************************
+* data that does not wrap is slid down with one memmove. Wrapped data is rotated
+* left by front with three reversals, which needs no scratch buffer.
+*/
+
+uint8_t deque_linearize(struct deque *dq)
+{
+        if (deque_is_null(dq)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (dq->front == 0) {
+                return DEQUE_SUCCESS;
+        }
+
+        if (dq->len <= dq->cap - dq->front) {
+                memmove(dq->buf, dq->buf + dq->front, dq->len);
+        } else {
+                deque_reverse(dq->buf, 0, dq->front);
+                deque_reverse(dq->buf, dq->front,
+                              (uint8_t) (dq->cap - dq->front));
+                deque_reverse(dq->buf, 0, dq->cap);
+        }
+
+        dq->front = 0;
+        dq->back = deque_add(dq, 0, dq->len);
+
+        return DEQUE_SUCCESS;
+}
+
+/*******************************************************************************
+* delimiter tracking
+*/
+
+uint8_t deque_set_delim(struct deque *dq, const unsigned char delim)
+{
+        if (deque_is_null(dq)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        dq->delim = delim;
+        dq->flags |= DEQUE_TRACK_DELIM;
+        dq->ndelim = deque_count(dq, dq->front, dq->len);
+
+        return DEQUE_SUCCESS;
+}
+
+/*******************************************************************************
+* overwrite mode
+*/
+
+uint8_t deque_set_overwrite(struct deque *dq, const uint8_t enable)
+{
+        if (deque_is_null(dq)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (enable) {
+                dq->flags |= DEQUE_OVERWRITE;
+        } else {
+                dq->flags &= (uint8_t) ~DEQUE_OVERWRITE;
+        }
+
+        dq->overwrites = 0;
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t deque_iter_new(struct deque_iter *it, const struct deque *dq)
+{
+        if (deque_is_null(it) || deque_is_null(dq)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        it->dq = dq;
+        it->idx = dq->front;
+        it->left = dq->len;
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+#ifdef DEQUE_STATS
+uint8_t deque_stats_read(struct deque *dq, struct deque_stats *stats,
+                         const uint8_t reset)
+{
+        if (deque_is_null(dq) || deque_is_null(stats)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        atomic {
+                *stats = dq->stats;
+
+                if (reset) {
+                        dq->stats = (struct deque_stats) {0};
+                        dq->stats.hwm = dq->len;
+                }
+        }
+
+        return DEQUE_SUCCESS;
+}
+#endif
+
+/*******************************************************************************
+* the hysteresis state restarts below high, then the current len is evaluated so
+* a deque that is already at or above high fires on_high immediately
+*/
+
+#ifdef DEQUE_WATERMARK
+uint8_t deque_set_watermark(struct deque *dq, const uint8_t low,
+                            const uint8_t high, deque_hook on_low,
+                            deque_hook on_high)
+{
+        if (deque_is_null(dq)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (high && (low >= high || high > dq->cap)) {
+                return DEQUE_CAP_BOUNDS;
+        }
+
+        dq->flags &= (uint8_t) ~DEQUE_ABOVE_HIGH;
+        dq->low = low;
+        dq->high = high;
+        dq->on_low = on_low;
+        dq->on_high = on_high;
+        deque_watermark(dq);
 
         return DEQUE_SUCCESS;
 }
+#endif
+
+/*******************************************************************************
+* search the occupied region in its two contiguous segments, front to the end
+* of the base array and then from the start of the base array
+*/
+
+uint8_t deque_find(const struct deque *dq, uint8_t *offset)
+{
+        if (deque_is_null(dq) || deque_is_null(offset)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (!deque_has_delim(*dq)) {
+                return DEQUE_NOT_FOUND;
+        }
+
+        const uint8_t head = (uint8_t) (dq->cap - dq->front);
+        const uint8_t seg = dq->len < head ? dq->len : head;
+        const unsigned char *hit = NULL;
+
+        hit = memchr(dq->buf + dq->front, dq->delim, seg);
+
+        if (hit) {
+                *offset = (uint8_t) (hit - (dq->buf + dq->front));
+                return DEQUE_SUCCESS;
+        }
+
+        hit = memchr(dq->buf, dq->delim, (size_t) (dq->len - seg));
+
+        if (hit) {
+                *offset = (uint8_t) (seg + (hit - dq->buf));
+                return DEQUE_SUCCESS;
+        }
+
+        return DEQUE_NOT_FOUND;
+}
@@ -3,8 +3,10 @@
 * MIT License
 * Double ended queue for unsigned char data. The deque is constructed over a
 * pre-existing base array. Do not write to the base array while the deque is in
-* use. The API functions do not use any dynamic allocation, but will work fine
-* if malloc/custom_alloc is used to allocate the struct deque.
+* use, except through the span API below. The API functions do not use any
+* dynamic allocation, but will work fine if malloc/custom_alloc is used to
+* allocate the struct deque. See pool.h to carve base arrays out of a static
+* region at runtime.
 */
 
 #ifndef DEQUE_H
@@ -18,12 +20,85 @@
 * @DEQUE_NULL_INPUT: input argument is a null pointer
 * @DEQUE_FULL: attempted to push data onto a full deque
 * @DEQUE_EMPTY: attempted to pop data off an empty deque
+* @DEQUE_NOT_FOUND: no delimiter is buffered
+* @DEQUE_INDEX_BOUNDS: attempted to access an element beyond the current size
 *******************************************************************************/
 #define DEQUE_SUCCESS           0
 #define DEQUE_CAP_BOUNDS        (uint8_t) '1'
 #define DEQUE_NULL_INPUT        (uint8_t) '2'
 #define DEQUE_FULL              (uint8_t) '3'
 #define DEQUE_EMPTY             (uint8_t) '4'
+#define DEQUE_NOT_FOUND         (uint8_t) '5'
+#define DEQUE_INDEX_BOUNDS      (uint8_t) '6'
+
+/*******************************************************************************
+* mode flags
+* @DEQUE_TRACK_DELIM: delimiter counting is enabled, see deque_set_delim()
+* @DEQUE_OVERWRITE: pushes onto a full deque evict, see deque_set_overwrite()
+* @DEQUE_ABOVE_HIGH: high watermark fired and low not yet, see
+* deque_set_watermark()
+*******************************************************************************/
+#define DEQUE_TRACK_DELIM       (uint8_t) 0x01
+#define DEQUE_OVERWRITE         (uint8_t) 0x02
+#define DEQUE_ABOVE_HIGH        (uint8_t) 0x04
+
+/*******************************************************************************
+* build profile
+* @DEQUE_INLINE: define to compile push/pop, deque_at() and deque_iter_next() as
+* static inline functions in every translation unit that includes this header.
+* This removes the call/ret and the register save/restore around each element
+* on AVR at the cost of flash per call site. The remaining functions are always
+* compiled out-of-line in deque.c. On failure these leave the data out-parameter
+* unwritten, and once inlined gcc can see that, so read it only on success or
+* initialize it to keep -Wmaybe-uninitialized quiet.
+* @DEQUE_UNCHECKED: define for release firmware to remove the pointer validation
+* from every function. DEQUE_NULL_INPUT is then never returned and passing a
+* null pointer is undefined. The capacity, full and empty checks remain.
+* @DEQUE_STATS: define to compile a struct deque_stats block into every struct
+* deque, see deque_stats_read(). Each push and pop then costs a few extra cycles.
+* @DEQUE_STATS_TOTAL: define alongside DEQUE_STATS to also count every byte
+* pushed in a 32-bit total.
+* @DEQUE_WATERMARK: define to compile low/high watermark hooks into every struct
+* deque, see deque_set_watermark(). Each push and pop then costs a compare.
+*******************************************************************************/
+#ifdef DEQUE_INLINE
+        #define DEQUE_OP static inline
+#else
+        #define DEQUE_OP
+#endif
+
+#ifdef DEQUE_UNCHECKED
+        #define deque_is_null(ptr) 0
+#else
+        #define deque_is_null(ptr) (!(ptr))
+#endif
+
+/*******************************************************************************
+* struct deque_stats
+* @hwm: high-water mark, the largest len since the last reset
+* @full: pushes rejected with DEQUE_FULL, saturates at UINT16_MAX
+* @empty: pops rejected with DEQUE_EMPTY, saturates at UINT16_MAX
+* @total: bytes pushed, wraps at UINT32_MAX, requires DEQUE_STATS_TOTAL
+* note: rejected span queries are not counted, only commit and release
+*******************************************************************************/
+#ifdef DEQUE_STATS
+        struct deque_stats {
+                uint8_t hwm;
+                uint16_t full;
+                uint16_t empty;
+                #ifdef DEQUE_STATS_TOTAL
+                        uint32_t total;
+                #endif
+        };
+#endif
+
+/*******************************************************************************
+* deque_hook - watermark callback, receives the deque whose len crossed
+*******************************************************************************/
+#ifdef DEQUE_WATERMARK
+        struct deque;
+        typedef void (*deque_hook)(struct deque *dq);
+#endif
 
 /*******************************************************************************
 * struct deque
@@ -31,6 +106,16 @@
 * @len: current size
 * @front: index of front element
 * @back: index of back element
+* @mask: cap - 1 when cap is a power of two, else zero
+* @flags: mode flags
+* @delim: delimiter byte, valid when DEQUE_TRACK_DELIM is set
+* @ndelim: number of delimiters currently buffered
+* @overwrites: elements evicted in overwrite mode, saturates at UINT16_MAX
+* @stats: occupancy statistics, requires DEQUE_STATS
+* @low: low watermark, requires DEQUE_WATERMARK
+* @high: high watermark, zero when disabled, requires DEQUE_WATERMARK
+* @on_low: called when len falls to low, requires DEQUE_WATERMARK
+* @on_high: called when len rises to high, requires DEQUE_WATERMARK
 * @buf: base array
 * note: all struct deque members are READ-ONLY
 *******************************************************************************/
@@ -39,15 +124,45 @@ struct deque {
         uint8_t len;
         uint8_t front;
         uint8_t back;
+        uint8_t mask;
+        uint8_t flags;
+        unsigned char delim;
+        uint8_t ndelim;
+        uint16_t overwrites;
+        #ifdef DEQUE_STATS
+                struct deque_stats stats;
+        #endif
+        #ifdef DEQUE_WATERMARK
+                uint8_t low;
+                uint8_t high;
+                deque_hook on_low;
+                deque_hook on_high;
+        #endif
         unsigned char *buf;
 };
 
+/*******************************************************************************
+* struct deque_iter
+* @dq: deque being walked
+* @idx: base array index of the next element
+* @left: number of elements not yet visited
+* note: all struct deque_iter members are READ-ONLY
+*******************************************************************************/
+struct deque_iter {
+        const struct deque *dq;
+        uint8_t idx;
+        uint8_t left;
+};
+
 /*******************************************************************************
 * deque_new() - initialize double ended queue
 * @buf: base array
 * @cap: length of base array
 * Returns: error code DEQUE_SUCCESS else DEQUE_CAP_BOUNDS or DEQUE_NULL_INPUT
-* note: do not read/write directly to base array after deque_new returns
+* note: do not read/write directly to base array after deque_new returns, except
+* through the regions handed out by deque_write_span() and deque_read_span()
+* note: prefer a power of two capacity. The indices then wrap with a bitmask
+* instead of a modulo, which on AVR is a call to the libgcc division routine.
 *******************************************************************************/
 uint8_t deque_new(struct deque *dq, unsigned char *buf, const uint8_t cap);
 
@@ -55,25 +170,199 @@ uint8_t deque_new(struct deque *dq, unsigned char *buf, const uint8_t cap);
 * deque_push_back()
 * Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT or DEQUE_FULL
 *******************************************************************************/
-uint8_t deque_push_back(struct deque *dq, const unsigned char data);
+DEQUE_OP uint8_t deque_push_back(struct deque *dq, const unsigned char data);
 
 /*******************************************************************************
 * deque_pop_back()
 * Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT or DEQUE_EMPTY
 *******************************************************************************/
-uint8_t deque_pop_back(struct deque *dq, unsigned char *data);
+DEQUE_OP uint8_t deque_pop_back(struct deque *dq, unsigned char *data);
 
 /*******************************************************************************
 * deque_push_front()
 * Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT or DEQUE_FULL
 *******************************************************************************/
-uint8_t deque_push_front(struct deque *dq, const unsigned char data);
+DEQUE_OP uint8_t deque_push_front(struct deque *dq, const unsigned char data);
 
 /*******************************************************************************
 * deque_pop_front()
 * Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT or DEQUE_EMPTY
 *******************************************************************************/
-uint8_t deque_pop_front(struct deque *dq, unsigned char *data);
+DEQUE_OP uint8_t deque_pop_front(struct deque *dq, unsigned char *data);
+
+/*******************************************************************************
+* deque_push_back_n() - push a block of data onto the back
+* @src: block of n bytes, src[0] is pushed first
+* @n: number of bytes in block
+* Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT or DEQUE_FULL
+* note: the block is pushed entirely or not at all
+*******************************************************************************/
+uint8_t deque_push_back_n(struct deque *dq, const unsigned char *src,
+                          uint8_t n);
+
+/*******************************************************************************
+* deque_pop_back_n() - pop a block of data off the back
+* @dst: receives the last n bytes in deque order, dst[n - 1] was the back
+* @n: number of bytes in block
+* Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT or DEQUE_EMPTY
+* note: the block is popped entirely or not at all
+*******************************************************************************/
+uint8_t deque_pop_back_n(struct deque *dq, unsigned char *dst, const uint8_t n);
+
+/*******************************************************************************
+* deque_push_front_n() - push a block of data onto the front
+* @src: block of n bytes, src[0] becomes the new front
+* @n: number of bytes in block
+* Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT or DEQUE_FULL
+* note: the block is pushed entirely or not at all. Block order is preserved,
+* which is the reverse of n calls to deque_push_front().
+*******************************************************************************/
+uint8_t deque_push_front_n(struct deque *dq, const unsigned char *src,
+                           uint8_t n);
+
+/*******************************************************************************
+* deque_pop_front_n() - pop a block of data off the front
+* @dst: receives the first n bytes in deque order, dst[0] was the front
+* @n: number of bytes in block
+* Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT or DEQUE_EMPTY
+* note: the block is popped entirely or not at all
+*******************************************************************************/
+uint8_t deque_pop_front_n(struct deque *dq, unsigned char *dst,
+                          const uint8_t n);
+
+/*******************************************************************************
+* deque_write_span() - get the largest contiguous free region at the back
+* @span: set to the first free byte of the base array
+* @n: set to the length of the free region
+* Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT or DEQUE_FULL
+* note: the caller may write up to n bytes at span and then must publish them
+* with deque_commit(). The region ends at the end of the base array, so a full
+* refill of a wrapped deque takes two spans.
+*******************************************************************************/
+uint8_t deque_write_span(struct deque *dq, unsigned char **span, uint8_t *n);
+
+/*******************************************************************************
+* deque_commit() - push n bytes already written into a write span
+* Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT or DEQUE_FULL
+*******************************************************************************/
+uint8_t deque_commit(struct deque *dq, const uint8_t n);
+
+/*******************************************************************************
+* deque_read_span() - get the largest contiguous occupied region at the front
+* @span: set to the front element in the base array
+* @n: set to the length of the occupied region
+* Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT or DEQUE_EMPTY
+* note: the caller may read up to n bytes at span and then may discard them
+* with deque_release(). If the data wraps, the remainder is in the next span.
+*******************************************************************************/
+uint8_t deque_read_span(const struct deque *dq, const unsigned char **span,
+                        uint8_t *n);
+
+/*******************************************************************************
+* deque_release() - pop n bytes off the front without copying them
+* Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT or DEQUE_EMPTY
+*******************************************************************************/
+uint8_t deque_release(struct deque *dq, const uint8_t n);
+
+/*******************************************************************************
+* deque_linearize() - rotate the base array in place so the front is at index 0
+* Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT
+* note: afterwards the len bytes of data are contiguous at buf[0] to buf[len - 1]
+* and can be handed to a parser directly. They are not null terminated.
+* note: costs O(cap) byte swaps when the data wraps, and a single memmove of len
+* bytes when it does not. Any outstanding span or iterator is invalidated.
+*******************************************************************************/
+uint8_t deque_linearize(struct deque *dq);
+
+/*******************************************************************************
+* deque_set_delim() - count occurrences of a delimiter on every push and pop
+* @delim: delimiter byte, e.g. '\n'
+* Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT
+* note: data already in the deque is counted once here. Afterwards the count
+* is kept by every operation, so deque_has_delim() is a constant-time query.
+*******************************************************************************/
+uint8_t deque_set_delim(struct deque *dq, const unsigned char delim);
+
+/*******************************************************************************
+* deque_set_overwrite() - select flight recorder behaviour when full
+* @enable: nonzero to overwrite, zero to restore the default DEQUE_FULL error
+* Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT
+* note: with overwrite enabled a push onto a full deque evicts the oldest
+* element from the opposite end, so push_back drops the front and push_front
+* drops the back. The bulk pushes evict as many elements as needed, and if a
+* block is longer than the capacity only the newest cap bytes are kept. Pushes
+* never fail with DEQUE_FULL. The span API is unaffected.
+* note: the overwrites counter is reset to zero by every call
+*******************************************************************************/
+uint8_t deque_set_overwrite(struct deque *dq, const uint8_t enable);
+
+#ifdef DEQUE_STATS
+/*******************************************************************************
+* deque_stats_read() - copy out the statistics block
+* @stats: set to a snapshot of the block
+* @reset: nonzero to restart counting after the snapshot is taken
+* Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT
+* note: the snapshot and reset are atomic with respect to interrupts on AVR, so
+* a deque shared with an ISR can be sampled from the main loop. After a reset
+* the high-water mark restarts from the current len.
+*******************************************************************************/
+uint8_t deque_stats_read(struct deque *dq, struct deque_stats *stats,
+                         const uint8_t reset);
+#endif
+
+#ifdef DEQUE_WATERMARK
+/*******************************************************************************
+* deque_set_watermark() - register occupancy threshold hooks
+* @low: on_low fires when len falls to low or below
+* @high: on_high fires when len rises to high or above, zero disables both hooks
+* @on_low: may be null
+* @on_high: may be null
+* Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT or DEQUE_CAP_BOUNDS
+* when low >= high or high > cap
+* note: the hooks alternate. on_high fires once on reaching high and not again
+* until on_low has fired on draining to low, so a consumer woken by on_high can
+* drain in one batch and a producer can hold flow control until on_low.
+* note: a hook runs inside the push or pop that crossed the threshold, possibly
+* in an ISR. Keep it short, e.g. set a flag, and do not push or pop the deque
+* from it.
+*******************************************************************************/
+uint8_t deque_set_watermark(struct deque *dq, const uint8_t low,
+                            const uint8_t high, deque_hook on_low,
+                            deque_hook on_high);
+#endif
+
+/*******************************************************************************
+* deque_find() - locate the first delimiter from the front
+* @offset: set to the distance from the front, so offset + 1 bytes form a line
+* Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT or DEQUE_NOT_FOUND
+* note: returns DEQUE_NOT_FOUND immediately when no delimiter is buffered,
+* otherwise scans at most two contiguous segments of the base array.
+*******************************************************************************/
+uint8_t deque_find(const struct deque *dq, uint8_t *offset);
+
+/*******************************************************************************
+* deque_at() - read an element without removing it
+* @i: distance from the front, 0 is the front and len - 1 is the back
+* @data: set to the element
+* Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT or DEQUE_INDEX_BOUNDS
+*******************************************************************************/
+DEQUE_OP uint8_t deque_at(const struct deque *dq, const uint8_t i,
+                          unsigned char *data);
+
+/*******************************************************************************
+* deque_iter_new() - start a front to back walk over the buffered data
+* Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT
+* note: the iterator is invalidated by any operation that modifies the deque
+*******************************************************************************/
+uint8_t deque_iter_new(struct deque_iter *it, const struct deque *dq);
+
+/*******************************************************************************
+* deque_iter_next() - read the next element of a walk
+* @data: set to the element
+* Returns: error code DEQUE_SUCCESS else DEQUE_NULL_INPUT or DEQUE_EMPTY once
+* every element has been visited
+*******************************************************************************/
+DEQUE_OP uint8_t deque_iter_next(struct deque_iter *it, unsigned char *data);
 
 /*******************************************************************************
 * helper macros
@@ -85,7 +374,17 @@ uint8_t deque_pop_front(struct deque *dq, unsigned char *data);
 #define deque_is_empty(dq) ((dq).len == 0)
 #define deque_is_not_empty(dq) (!((dq).len == 0))
 
-#define deque_peek_back(dq) ((dq).buf[(((dq).back + (dq).cap - 1) % (dq).cap)])
+#define deque_peek_back(dq) ((dq).buf[(dq).back ? (dq).back - 1 : (dq).cap - 1])
 #define deque_peek_front(dq) ((dq).buf[(dq).front])
 
+#define deque_has_delim(dq) ((dq).ndelim != 0)
+
+#define deque_foreach(it, dq, data)                                            \
+        for (deque_iter_new(&(it), &(dq));                                     \
+             deque_iter_next(&(it), &(data)) == DEQUE_SUCCESS;)
+
+#ifdef DEQUE_INLINE
+        #include "deque_ops.h"
+#endif
+
 #endif /* DEQUE_H */
@@ -0,0 +1,349 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Double ended queue with 16-bit indices implementation. The logic mirrors
+* deque.c and deque_ops.h, with index arithmetic that cannot overflow near the
+* uint16_t limit.
+*/
+
+#include <string.h>
+
+#include "deque16.h"
+
+/*******************************************************************************
+* index wraparound, see deque_ops.h
+*/
+
+static inline uint16_t deque16_next(const struct deque16 *dq, const uint16_t i)
+{
+        if (dq->mask) {
+                return (uint16_t) ((i + 1) & dq->mask);
+        }
+
+        return (uint16_t) ((i + 1) % dq->cap);
+}
+
+static inline uint16_t deque16_prev(const struct deque16 *dq, const uint16_t i)
+{
+        if (dq->mask) {
+                return (uint16_t) ((i - 1) & dq->mask);
+        }
+
+        return (uint16_t) (i ? i - 1 : dq->cap - 1);
+}
+
+/*******************************************************************************
+* multi-position index arithmetic for the bulk operations. Written so that no
+* intermediate value exceeds cap, which may be close to the uint16_t limit.
+*/
+
+static inline uint16_t deque16_add(const struct deque16 *dq, const uint16_t i,
+                                   const uint16_t n)
+{
+        const uint16_t head = (uint16_t) (dq->cap - i);
+
+        if (n >= head) {
+                return (uint16_t) (n - head);
+        }
+
+        return (uint16_t) (i + n);
+}
+
+static inline uint16_t deque16_sub(const struct deque16 *dq, const uint16_t i,
+                                   const uint16_t n)
+{
+        if (i >= n) {
+                return (uint16_t) (i - n);
+        }
+
+        return (uint16_t) (dq->cap - (n - i));
+}
+
+/*******************************************************************************
+* copy a block into or out of the base array starting at index i
+*/
+
+static void deque16_copy_in(struct deque16 *dq, const uint16_t i,
+                            const unsigned char *src, const uint16_t n)
+{
+        const uint16_t head = (uint16_t) (dq->cap - i);
+
+        if (n <= head) {
+                memcpy(dq->buf + i, src, n);
+        } else {
+                memcpy(dq->buf + i, src, head);
+                memcpy(dq->buf, src + head, (size_t) (n - head));
+        }
+}
+
+static void deque16_copy_out(const struct deque16 *dq, const uint16_t i,
+                             unsigned char *dst, const uint16_t n)
+{
+        const uint16_t head = (uint16_t) (dq->cap - i);
+
+        if (n <= head) {
+                memcpy(dst, dq->buf + i, n);
+        } else {
+                memcpy(dst, dq->buf + i, head);
+                memcpy(dst + head, dq->buf, (size_t) (n - head));
+        }
+}
+
+/******************************************************************************/
+
+uint8_t deque16_new(struct deque16 *dq, unsigned char *buf, const uint16_t cap)
+{
+        if (deque_is_null(buf)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (cap == 0) {
+                return DEQUE_CAP_BOUNDS;
+        }
+
+        dq->cap = cap;
+        dq->len = 0;
+        dq->front = 0;
+        dq->back = 0;
+        dq->mask = (cap & (cap - 1)) ? 0 : (uint16_t) (cap - 1);
+        dq->buf = buf;
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t deque16_push_back(struct deque16 *dq, const unsigned char data)
+{
+        if (deque_is_null(dq)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (deque16_is_full(*dq)) {
+                return DEQUE_FULL;
+        }
+
+        dq->buf[dq->back] = data;
+        dq->back = deque16_next(dq, dq->back);
+        dq->len++;
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t deque16_pop_back(struct deque16 *dq, unsigned char *data)
+{
+        if (deque_is_null(dq) || deque_is_null(data)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (deque16_is_empty(*dq)) {
+                return DEQUE_EMPTY;
+        }
+
+        dq->back = deque16_prev(dq, dq->back);
+        *data = dq->buf[dq->back];
+        dq->len--;
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t deque16_push_front(struct deque16 *dq, const unsigned char data)
+{
+        if (deque_is_null(dq)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (deque16_is_full(*dq)) {
+                return DEQUE_FULL;
+        }
+
+        dq->front = deque16_prev(dq, dq->front);
+        dq->buf[dq->front] = data;
+        dq->len++;
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t deque16_pop_front(struct deque16 *dq, unsigned char *data)
+{
+        if (deque_is_null(dq) || deque_is_null(data)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (deque16_is_empty(*dq)) {
+                return DEQUE_EMPTY;
+        }
+
+        *data = dq->buf[dq->front];
+        dq->front = deque16_next(dq, dq->front);
+        dq->len--;
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t deque16_push_back_n(struct deque16 *dq, const unsigned char *src,
+                            const uint16_t n)
+{
+        if (deque_is_null(dq) || deque_is_null(src)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (n > dq->cap - dq->len) {
+                return DEQUE_FULL;
+        }
+
+        deque16_copy_in(dq, dq->back, src, n);
+        dq->back = deque16_add(dq, dq->back, n);
+        dq->len = (uint16_t) (dq->len + n);
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t deque16_pop_back_n(struct deque16 *dq, unsigned char *dst,
+                           const uint16_t n)
+{
+        if (deque_is_null(dq) || deque_is_null(dst)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (n > dq->len) {
+                return DEQUE_EMPTY;
+        }
+
+        dq->back = deque16_sub(dq, dq->back, n);
+        deque16_copy_out(dq, dq->back, dst, n);
+        dq->len = (uint16_t) (dq->len - n);
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t deque16_push_front_n(struct deque16 *dq, const unsigned char *src,
+                             const uint16_t n)
+{
+        if (deque_is_null(dq) || deque_is_null(src)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (n > dq->cap - dq->len) {
+                return DEQUE_FULL;
+        }
+
+        dq->front = deque16_sub(dq, dq->front, n);
+        deque16_copy_in(dq, dq->front, src, n);
+        dq->len = (uint16_t) (dq->len + n);
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t deque16_pop_front_n(struct deque16 *dq, unsigned char *dst,
+                            const uint16_t n)
+{
+        if (deque_is_null(dq) || deque_is_null(dst)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (n > dq->len) {
+                return DEQUE_EMPTY;
+        }
+
+        deque16_copy_out(dq, dq->front, dst, n);
+        dq->front = deque16_add(dq, dq->front, n);
+        dq->len = (uint16_t) (dq->len - n);
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t deque16_write_span(struct deque16 *dq, unsigned char **span,
+                           uint16_t *n)
+{
+        if (deque_is_null(dq) || deque_is_null(span) || deque_is_null(n)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (deque16_is_full(*dq)) {
+                *n = 0;
+                return DEQUE_FULL;
+        }
+
+        const uint16_t avail = (uint16_t) (dq->cap - dq->len);
+        const uint16_t head = (uint16_t) (dq->cap - dq->back);
+
+        *span = dq->buf + dq->back;
+        *n = avail < head ? avail : head;
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t deque16_commit(struct deque16 *dq, const uint16_t n)
+{
+        if (deque_is_null(dq)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (n > dq->cap - dq->len) {
+                return DEQUE_FULL;
+        }
+
+        dq->back = deque16_add(dq, dq->back, n);
+        dq->len = (uint16_t) (dq->len + n);
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t deque16_read_span(const struct deque16 *dq, const unsigned char **span,
+                          uint16_t *n)
+{
+        if (deque_is_null(dq) || deque_is_null(span) || deque_is_null(n)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (deque16_is_empty(*dq)) {
+                *n = 0;
+                return DEQUE_EMPTY;
+        }
+
+        const uint16_t head = (uint16_t) (dq->cap - dq->front);
+
+        *span = dq->buf + dq->front;
+        *n = dq->len < head ? dq->len : head;
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t deque16_release(struct deque16 *dq, const uint16_t n)
+{
+        if (deque_is_null(dq)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (n > dq->len) {
+                return DEQUE_EMPTY;
+        }
+
+        dq->front = deque16_add(dq, dq->front, n);
+        dq->len = (uint16_t) (dq->len - n);
+
+        return DEQUE_SUCCESS;
+}
@@ -0,0 +1,90 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Double ended queue for unsigned char data with 16-bit indices. This is the
+* large capacity variant of struct deque for buffers longer than 255 bytes, e.g.
+* bursty serial input at high baud rates. Every function mirrors the struct
+* deque function of the same name and shares its error codes and build profile
+* (DEQUE_UNCHECKED), see deque.h. The 16-bit index arithmetic costs extra cycles
+* on AVR, so prefer struct deque for any buffer that fits in 255 bytes.
+*/
+
+#ifndef DEQUE16_H
+#define DEQUE16_H
+
+#include <stdint.h>
+
+#include "deque.h"
+
+/*******************************************************************************
+* struct deque16
+* @cap: maximum capacity
+* @len: current size
+* @front: index of front element
+* @back: index of back element
+* @mask: cap - 1 when cap is a power of two, else zero
+* @buf: base array
+* note: all struct deque16 members are READ-ONLY
+*******************************************************************************/
+struct deque16 {
+        uint16_t cap;
+        uint16_t len;
+        uint16_t front;
+        uint16_t back;
+        uint16_t mask;
+        unsigned char *buf;
+};
+
+/*******************************************************************************
+* deque16_new() - initialize double ended queue
+* @buf: base array
+* @cap: length of base array
+* Returns: error code DEQUE_SUCCESS else DEQUE_CAP_BOUNDS or DEQUE_NULL_INPUT
+*******************************************************************************/
+uint8_t deque16_new(struct deque16 *dq, unsigned char *buf, const uint16_t cap);
+
+/*******************************************************************************
+* single element operations
+*******************************************************************************/
+uint8_t deque16_push_back(struct deque16 *dq, const unsigned char data);
+uint8_t deque16_pop_back(struct deque16 *dq, unsigned char *data);
+uint8_t deque16_push_front(struct deque16 *dq, const unsigned char data);
+uint8_t deque16_pop_front(struct deque16 *dq, unsigned char *data);
+
+/*******************************************************************************
+* bulk operations
+*******************************************************************************/
+uint8_t deque16_push_back_n(struct deque16 *dq, const unsigned char *src,
+                            const uint16_t n);
+uint8_t deque16_pop_back_n(struct deque16 *dq, unsigned char *dst,
+                           const uint16_t n);
+uint8_t deque16_push_front_n(struct deque16 *dq, const unsigned char *src,
+                             const uint16_t n);
+uint8_t deque16_pop_front_n(struct deque16 *dq, unsigned char *dst,
+                            const uint16_t n);
+
+/*******************************************************************************
+* span operations
+*******************************************************************************/
+uint8_t deque16_write_span(struct deque16 *dq, unsigned char **span,
+                           uint16_t *n);
+uint8_t deque16_commit(struct deque16 *dq, const uint16_t n);
+uint8_t deque16_read_span(const struct deque16 *dq, const unsigned char **span,
+                          uint16_t *n);
+uint8_t deque16_release(struct deque16 *dq, const uint16_t n);
+
+/*******************************************************************************
+* helper macros
+* note: macros expect a struct deque16, not a reference to a struct deque16
+*******************************************************************************/
+#define deque16_is_full(dq) ((dq).cap == (dq).len)
+#define deque16_is_not_full(dq) (!((dq).cap == (dq).len))
+
+#define deque16_is_empty(dq) ((dq).len == 0)
+#define deque16_is_not_empty(dq) (!((dq).len == 0))
+
+#define deque16_peek_back(dq) \
+        ((dq).buf[(dq).back ? (dq).back - 1 : (dq).cap - 1])
+#define deque16_peek_front(dq) ((dq).buf[(dq).front])
+
+#endif /* DEQUE16_H */
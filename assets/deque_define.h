@@ -0,0 +1,197 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Typed double ended queue generator. DEQUE_DEFINE(name, type, capacity) emits
+* a struct name and a family of static inline name_xxx() functions over a base
+* array of capacity elements of any type, e.g. uint16_t ADC samples or small
+* structs. The capacity is a compile-time constant so the index wraparound is
+* folded by the compiler into a bitmask or a compare. As with struct deque the
+* base array is owned by the caller and no dynamic allocation is performed.
+* Error codes are shared with deque.h.
+*
+* usage:
+*       DEQUE_DEFINE(adc_fifo, uint16_t, 32);
+*
+*       uint16_t samples[32];
+*       struct adc_fifo fifo;
+*       adc_fifo_new(&fifo, samples);
+*       adc_fifo_push_back(&fifo, ADC);
+*/
+
+#ifndef DEQUE_DEFINE_H
+#define DEQUE_DEFINE_H
+
+#include <stdint.h>
+
+#include "deque.h"
+
+/*******************************************************************************
+* DEQUE_DEFINE() - generate a typed deque
+* @name: prefix of the generated struct and functions
+* @type: element type, copied by assignment
+* @capacity: length of the base array, 1 to 255
+*
+* generated functions:
+*       name_new(dq, buf) - buf must hold capacity elements
+*       name_push_back(dq, data), name_push_front(dq, data)
+*       name_pop_back(dq, &data), name_pop_front(dq, &data)
+*       name_peek_back(dq, &data), name_peek_front(dq, &data)
+*       name_is_full(dq), name_is_empty(dq)
+*
+* Return codes match the struct deque equivalents. The generated struct members
+* are READ-ONLY, and the base array must not be touched while the deque is in
+* use.
+*******************************************************************************/
+#define DEQUE_DEFINE(name, type, capacity)                                     \
+                                                                               \
+struct name {                                                                  \
+        uint8_t len;                                                           \
+        uint8_t front;                                                         \
+        uint8_t back;                                                          \
+        type *buf;                                                             \
+};                                                                             \
+                                                                               \
+static inline uint8_t name##_next(const uint8_t i)                             \
+{                                                                              \
+        if (((capacity) & ((capacity) - 1)) == 0) {                            \
+                return (uint8_t) ((i + 1) & ((capacity) - 1));                 \
+        }                                                                      \
+                                                                               \
+        return (uint8_t) (i == (capacity) - 1 ? 0 : i + 1);                    \
+}                                                                              \
+                                                                               \
+static inline uint8_t name##_prev(const uint8_t i)                             \
+{                                                                              \
+        if (((capacity) & ((capacity) - 1)) == 0) {                            \
+                return (uint8_t) ((i - 1) & ((capacity) - 1));                 \
+        }                                                                      \
+                                                                               \
+        return (uint8_t) (i == 0 ? (capacity) - 1 : i - 1);                    \
+}                                                                              \
+                                                                               \
+static inline uint8_t name##_is_full(const struct name *dq)                    \
+{                                                                              \
+        return dq->len == (capacity);                                          \
+}                                                                              \
+                                                                               \
+static inline uint8_t name##_is_empty(const struct name *dq)                   \
+{                                                                              \
+        return dq->len == 0;                                                   \
+}                                                                              \
+                                                                               \
+static inline uint8_t name##_new(struct name *dq, type *buf)                   \
+{                                                                              \
+        if (deque_is_null(dq) || deque_is_null(buf)) {                         \
+                return DEQUE_NULL_INPUT;                                       \
+        }                                                                      \
+                                                                               \
+        dq->len = 0;                                                           \
+        dq->front = 0;                                                         \
+        dq->back = 0;                                                          \
+        dq->buf = buf;                                                         \
+                                                                               \
+        return DEQUE_SUCCESS;                                                  \
+}                                                                              \
+                                                                               \
+static inline uint8_t name##_push_back(struct name *dq, const type data)       \
+{                                                                              \
+        if (deque_is_null(dq)) {                                               \
+                return DEQUE_NULL_INPUT;                                       \
+        }                                                                      \
+                                                                               \
+        if (name##_is_full(dq)) {                                              \
+                return DEQUE_FULL;                                             \
+        }                                                                      \
+                                                                               \
+        dq->buf[dq->back] = data;                                              \
+        dq->back = name##_next(dq->back);                                      \
+        dq->len++;                                                             \
+                                                                               \
+        return DEQUE_SUCCESS;                                                  \
+}                                                                              \
+                                                                               \
+static inline uint8_t name##_pop_back(struct name *dq, type *data)             \
+{                                                                              \
+        if (deque_is_null(dq) || deque_is_null(data)) {                        \
+                return DEQUE_NULL_INPUT;                                       \
+        }                                                                      \
+                                                                               \
+        if (name##_is_empty(dq)) {                                             \
+                return DEQUE_EMPTY;                                            \
+        }                                                                      \
+                                                                               \
+        dq->back = name##_prev(dq->back);                                      \
+        *data = dq->buf[dq->back];                                             \
+        dq->len--;                                                             \
+                                                                               \
+        return DEQUE_SUCCESS;                                                  \
+}                                                                              \
+                                                                               \
+static inline uint8_t name##_push_front(struct name *dq, const type data)      \
+{                                                                              \
+        if (deque_is_null(dq)) {                                               \
+                return DEQUE_NULL_INPUT;                                       \
+        }                                                                      \
+                                                                               \
+        if (name##_is_full(dq)) {                                              \
+                return DEQUE_FULL;                                             \
+        }                                                                      \
+                                                                               \
+        dq->front = name##_prev(dq->front);                                    \
+        dq->buf[dq->front] = data;                                             \
+        dq->len++;                                                             \
+                                                                               \
+        return DEQUE_SUCCESS;                                                  \
+}                                                                              \
+                                                                               \
+static inline uint8_t name##_pop_front(struct name *dq, type *data)            \
+{                                                                              \
+        if (deque_is_null(dq) || deque_is_null(data)) {                        \
+                return DEQUE_NULL_INPUT;                                       \
+        }                                                                      \
+                                                                               \
+        if (name##_is_empty(dq)) {                                             \
+                return DEQUE_EMPTY;                                            \
+        }                                                                      \
+                                                                               \
+        *data = dq->buf[dq->front];                                            \
+        dq->front = name##_next(dq->front);                                    \
+        dq->len--;                                                             \
+                                                                               \
+        return DEQUE_SUCCESS;                                                  \
+}                                                                              \
+                                                                               \
+static inline uint8_t name##_peek_back(const struct name *dq, type *data)      \
+{                                                                              \
+        if (deque_is_null(dq) || deque_is_null(data)) {                        \
+                return DEQUE_NULL_INPUT;                                       \
+        }                                                                      \
+                                                                               \
+        if (name##_is_empty(dq)) {                                             \
+                return DEQUE_EMPTY;                                            \
+        }                                                                      \
+                                                                               \
+        *data = dq->buf[name##_prev(dq->back)];                                \
+                                                                               \
+        return DEQUE_SUCCESS;                                                  \
+}                                                                              \
+                                                                               \
+static inline uint8_t name##_peek_front(const struct name *dq, type *data)     \
+{                                                                              \
+        if (deque_is_null(dq) || deque_is_null(data)) {                        \
+                return DEQUE_NULL_INPUT;                                       \
+        }                                                                      \
+                                                                               \
+        if (name##_is_empty(dq)) {                                             \
+                return DEQUE_EMPTY;                                            \
+        }                                                                      \
+                                                                               \
+        *data = dq->buf[dq->front];                                            \
+                                                                               \
+        return DEQUE_SUCCESS;                                                  \
+}                                                                              \
+                                                                               \
+_Static_assert((capacity) > 0 && (capacity) <= 255,                           \
+               "DEQUE_DEFINE capacity must be within 1 to 255")
+
+#endif /* DEQUE_DEFINE_H */
@@ -0,0 +1,305 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Double ended queue single element operations. This file is compiled into
+* deque.c by default. When DEQUE_INLINE is defined it is also pulled into
+* deque.h, and every translation unit gets static inline copies instead.
+* Do not include this file directly.
+*/
+
+#ifndef DEQUE_OPS_H
+#define DEQUE_OPS_H
+
+#include "deque.h"
+
+/*******************************************************************************
+* index wraparound. The mask is checked at runtime but it was fixed by deque_new
+* so the branch always resolves the same way for a given deque. The modulo path
+* is only taken by deques with a capacity that is not a power of two.
+*/
+
+static inline uint8_t deque_next(const struct deque *dq, const uint8_t i)
+{
+        if (dq->mask) {
+                return (uint8_t) ((i + 1) & dq->mask);
+        }
+
+        return (uint8_t) ((i + 1) % dq->cap);
+}
+
+static inline uint8_t deque_prev(const struct deque *dq, const uint8_t i)
+{
+        if (dq->mask) {
+                return (uint8_t) ((i - 1) & dq->mask);
+        }
+
+        return (uint8_t) ((i + dq->cap - 1) % dq->cap);
+}
+
+/*******************************************************************************
+* delimiter counting for a single element entering or leaving the deque
+*/
+
+static inline void deque_track_in(struct deque *dq, const unsigned char data)
+{
+        if ((dq->flags & DEQUE_TRACK_DELIM) && data == dq->delim) {
+                dq->ndelim++;
+        }
+}
+
+static inline void deque_track_out(struct deque *dq, const unsigned char data)
+{
+        if ((dq->flags & DEQUE_TRACK_DELIM) && data == dq->delim) {
+                dq->ndelim--;
+        }
+}
+
+/*******************************************************************************
+* statistics updates, compiled out entirely unless DEQUE_STATS is defined. The
+* failure counters saturate so that a long running deque never reads as idle.
+*/
+
+#ifdef DEQUE_STATS
+        static inline void deque_stats_in(struct deque *dq, const uint8_t n)
+        {
+                if (dq->len > dq->stats.hwm) {
+                        dq->stats.hwm = dq->len;
+                }
+
+                #ifdef DEQUE_STATS_TOTAL
+                        dq->stats.total += n;
+                #else
+                        (void) n;
+                #endif
+        }
+
+        static inline void deque_stats_full(struct deque *dq)
+        {
+                if (dq->stats.full != UINT16_MAX) {
+                        dq->stats.full++;
+                }
+        }
+
+        static inline void deque_stats_empty(struct deque *dq)
+        {
+                if (dq->stats.empty != UINT16_MAX) {
+                        dq->stats.empty++;
+                }
+        }
+#else
+        #define deque_stats_in(dq, n) ((void) 0)
+        #define deque_stats_full(dq) ((void) 0)
+        #define deque_stats_empty(dq) ((void) 0)
+#endif
+
+/*******************************************************************************
+* watermark hysteresis, compiled out entirely unless DEQUE_WATERMARK is defined.
+* Called once after every operation that changes len, so a bulk operation that
+* jumps straight past a threshold still fires the hook exactly once.
+*/
+
+#ifdef DEQUE_WATERMARK
+        static inline void deque_watermark(struct deque *dq)
+        {
+                if (dq->flags & DEQUE_ABOVE_HIGH) {
+                        if (dq->len <= dq->low) {
+                                dq->flags &= (uint8_t) ~DEQUE_ABOVE_HIGH;
+
+                                if (dq->on_low) {
+                                        dq->on_low(dq);
+                                }
+                        }
+                } else if (dq->high && dq->len >= dq->high) {
+                        dq->flags |= DEQUE_ABOVE_HIGH;
+
+                        if (dq->on_high) {
+                                dq->on_high(dq);
+                        }
+                }
+        }
+#else
+        #define deque_watermark(dq) ((void) 0)
+#endif
+
+/*******************************************************************************
+* overwrite mode eviction of the oldest element to make room for one push
+*/
+
+static inline void deque_count_overwrites(struct deque *dq, const uint8_t n)
+{
+        if (dq->overwrites > UINT16_MAX - n) {
+                dq->overwrites = UINT16_MAX;
+        } else {
+                dq->overwrites = (uint16_t) (dq->overwrites + n);
+        }
+}
+
+static inline void deque_evict_front(struct deque *dq)
+{
+        deque_track_out(dq, dq->buf[dq->front]);
+        dq->front = deque_next(dq, dq->front);
+        dq->len--;
+        deque_count_overwrites(dq, 1);
+}
+
+static inline void deque_evict_back(struct deque *dq)
+{
+        dq->back = deque_prev(dq, dq->back);
+        deque_track_out(dq, dq->buf[dq->back]);
+        dq->len--;
+        deque_count_overwrites(dq, 1);
+}
+
+/*******************************************************************************
+* place data then increment index
+*/
+
+DEQUE_OP uint8_t deque_push_back(struct deque *dq, const unsigned char data)
+{
+        if (deque_is_null(dq)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (deque_is_full(*dq)) {
+                if (!(dq->flags & DEQUE_OVERWRITE)) {
+                        deque_stats_full(dq);
+                        return DEQUE_FULL;
+                }
+
+                deque_evict_front(dq);
+        }
+
+        dq->buf[dq->back] = data;
+        dq->back = deque_next(dq, dq->back);
+        dq->len++;
+        deque_stats_in(dq, 1);
+        deque_track_in(dq, data);
+        deque_watermark(dq);
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************
+* decrement index then get data
+*/
+
+DEQUE_OP uint8_t deque_pop_back(struct deque *dq, unsigned char *data) {
+        if (deque_is_null(dq) || deque_is_null(data)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (deque_is_empty(*dq)) {
+                deque_stats_empty(dq);
+                return DEQUE_EMPTY;
+        }
+
+        dq->back = deque_prev(dq, dq->back);
+        *data = dq->buf[dq->back];
+        dq->len--;
+        deque_track_out(dq, *data);
+        deque_watermark(dq);
+
+        return DEQUE_SUCCESS;
+
+}
+
+/******************************************************************************
+* decrement index then place data
+*/
+
+DEQUE_OP uint8_t deque_push_front(struct deque *dq, const unsigned char data)
+{
+        if (deque_is_null(dq)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (deque_is_full(*dq)) {
+                if (!(dq->flags & DEQUE_OVERWRITE)) {
+                        deque_stats_full(dq);
+                        return DEQUE_FULL;
+                }
+
+                deque_evict_back(dq);
+        }
+
+        dq->front = deque_prev(dq, dq->front);
+        dq->buf[dq->front] = data;
+        dq->len++;
+        deque_stats_in(dq, 1);
+        deque_track_in(dq, data);
+        deque_watermark(dq);
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************
+* get data then increment index
+*/
+
+DEQUE_OP uint8_t deque_pop_front(struct deque *dq, unsigned char *data) {
+        if (deque_is_null(dq) || deque_is_null(data)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (deque_is_empty(*dq)) {
+                deque_stats_empty(dq);
+                return DEQUE_EMPTY;
+        }
+
+        *data = dq->buf[dq->front];
+        dq->front = deque_next(dq, dq->front);
+        dq->len--;
+        deque_track_out(dq, *data);
+        deque_watermark(dq);
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************
+* offset from front then wrap, i < len so a single subtraction suffices
+*/
+
+DEQUE_OP uint8_t deque_at(const struct deque *dq, const uint8_t i,
+                          unsigned char *data)
+{
+        if (deque_is_null(dq) || deque_is_null(data)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (i >= dq->len) {
+                return DEQUE_INDEX_BOUNDS;
+        }
+
+        uint16_t j = (uint16_t) (dq->front + i);
+
+        if (j >= dq->cap) {
+                j = (uint16_t) (j - dq->cap);
+        }
+
+        *data = dq->buf[j];
+
+        return DEQUE_SUCCESS;
+}
+
+/******************************************************************************
+* get data then increment iterator index
+*/
+
+DEQUE_OP uint8_t deque_iter_next(struct deque_iter *it, unsigned char *data)
+{
+        if (deque_is_null(it) || deque_is_null(data)) {
+                return DEQUE_NULL_INPUT;
+        }
+
+        if (it->left == 0) {
+                return DEQUE_EMPTY;
+        }
+
+        *data = it->dq->buf[it->idx];
+        it->idx = deque_next(it->dq, it->idx);
+        it->left--;
+
+        return DEQUE_SUCCESS;
+}
+
+#endif /* DEQUE_OPS_H */
@@ -0,0 +1,82 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Variable length record queue implementation
+*/
+
+#include "msgq.h"
+
+/******************************************************************************/
+
+uint8_t msgq_new(struct msgq *q, unsigned char *buf, const uint8_t cap)
+{
+        if (deque_is_null(q) || deque_is_null(buf)) {
+                return MSGQ_NULL_INPUT;
+        }
+
+        if (cap < 2) {
+                return MSGQ_CAP_BOUNDS;
+        }
+
+        deque_new(&q->dq, buf, cap);
+        q->count = 0;
+
+        return MSGQ_SUCCESS;
+}
+
+/*******************************************************************************
+* the free space is checked for prefix and body together before anything is
+* pushed, so the two deque pushes below cannot fail
+*/
+
+uint8_t msgq_push_record(struct msgq *q, const unsigned char *src,
+                         const uint8_t n)
+{
+        if (deque_is_null(q) || deque_is_null(src)) {
+                return MSGQ_NULL_INPUT;
+        }
+
+        if (n == 0 || n >= q->dq.cap) {
+                return MSGQ_LEN_BOUNDS;
+        }
+
+        if (n >= q->dq.cap - q->dq.len) {
+                return MSGQ_FULL;
+        }
+
+        deque_push_back(&q->dq, n);
+        deque_push_back_n(&q->dq, src, n);
+        q->count++;
+
+        return MSGQ_SUCCESS;
+}
+
+/*******************************************************************************
+* the prefix is inspected in place and only popped once the body is known to
+* fit in the destination
+*/
+
+uint8_t msgq_pop_record(struct msgq *q, unsigned char *dst, const uint8_t size,
+                        uint8_t *n)
+{
+        if (deque_is_null(q) || deque_is_null(dst) || deque_is_null(n)) {
+                return MSGQ_NULL_INPUT;
+        }
+
+        if (msgq_is_empty(*q)) {
+                return MSGQ_EMPTY;
+        }
+
+        unsigned char len = msgq_front_len(*q);
+        *n = len;
+
+        if (len > size) {
+                return MSGQ_LEN_BOUNDS;
+        }
+
+        deque_pop_front(&q->dq, &len);
+        deque_pop_front_n(&q->dq, dst, len);
+        q->count--;
+
+        return MSGQ_SUCCESS;
+}
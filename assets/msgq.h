@@ -0,0 +1,91 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Variable length record queue for unsigned char data. Each record is stored in
+* a struct deque base array as a one byte length prefix followed by the record
+* body, so a producer hands over a whole line or packet in one push and the
+* consumer takes it back in one pop without scanning for a delimiter. Records
+* are never split: a push or pop moves the entire frame or nothing. Like the
+* deque, the queue is constructed over a caller-owned base array and does not
+* use any dynamic allocation. The DEQUE_UNCHECKED build profile applies here too.
+*/
+
+#ifndef MSGQ_H
+#define MSGQ_H
+
+#include <stdint.h>
+
+#include "deque.h"
+
+/*******************************************************************************
+* API error codes
+* @MSGQ_CAP_BOUNDS: attempted to initialize queue with a capacity below 2
+* @MSGQ_NULL_INPUT: input argument is a null pointer
+* @MSGQ_FULL: not enough free space for the record and its prefix
+* @MSGQ_EMPTY: attempted to pop a record off an empty queue
+* @MSGQ_LEN_BOUNDS: record is empty, longer than the queue can ever hold, or
+* longer than the destination buffer
+*******************************************************************************/
+#define MSGQ_SUCCESS            0
+#define MSGQ_CAP_BOUNDS         (uint8_t) '1'
+#define MSGQ_NULL_INPUT         (uint8_t) '2'
+#define MSGQ_FULL               (uint8_t) '3'
+#define MSGQ_EMPTY              (uint8_t) '4'
+#define MSGQ_LEN_BOUNDS         (uint8_t) '5'
+
+/*******************************************************************************
+* struct msgq
+* @dq: byte deque holding the length prefixed records
+* @count: number of records currently queued
+* note: all struct msgq members are READ-ONLY
+*******************************************************************************/
+struct msgq {
+        struct deque dq;
+        uint8_t count;
+};
+
+/*******************************************************************************
+* msgq_new() - initialize record queue
+* @buf: base array
+* @cap: length of base array, at least 2
+* Returns: error code MSGQ_SUCCESS else MSGQ_CAP_BOUNDS or MSGQ_NULL_INPUT
+* note: each record costs one byte of the base array in addition to its body,
+* so the longest record that can be queued is cap - 1 bytes
+*******************************************************************************/
+uint8_t msgq_new(struct msgq *q, unsigned char *buf, const uint8_t cap);
+
+/*******************************************************************************
+* msgq_push_record() - append a record to the back of the queue
+* @src: record body
+* @n: record length, 1 to cap - 1
+* Returns: error code MSGQ_SUCCESS else MSGQ_NULL_INPUT, MSGQ_LEN_BOUNDS or
+* MSGQ_FULL
+*******************************************************************************/
+uint8_t msgq_push_record(struct msgq *q, const unsigned char *src,
+                         const uint8_t n);
+
+/*******************************************************************************
+* msgq_pop_record() - remove the record at the front of the queue
+* @dst: destination buffer
+* @size: length of the destination buffer
+* @n: set to the record length
+* Returns: error code MSGQ_SUCCESS else MSGQ_NULL_INPUT, MSGQ_EMPTY or
+* MSGQ_LEN_BOUNDS
+* note: on MSGQ_LEN_BOUNDS the record is left at the front of the queue and n is
+* set to its length, so the caller can retry with a large enough buffer
+*******************************************************************************/
+uint8_t msgq_pop_record(struct msgq *q, unsigned char *dst, const uint8_t size,
+                        uint8_t *n);
+
+/*******************************************************************************
+* helper macros
+* note: macros expect a struct msgq, not a reference to a struct msgq
+* note: msgq_front_len is only meaningful when the queue is not empty
+*******************************************************************************/
+#define msgq_is_empty(q) ((q).count == 0)
+#define msgq_is_not_empty(q) (!((q).count == 0))
+
+#define msgq_count(q) ((q).count)
+#define msgq_front_len(q) (deque_peek_front((q).dq))
+
+#endif /* MSGQ_H */
@@ -0,0 +1,100 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Fixed block pool allocator implementation
+*/
+
+#include <stddef.h>
+
+#include "pool.h"
+
+/*******************************************************************************
+* block i starts at offset i * block. The product can exceed 255, so it is
+* computed in 16 bits.
+*/
+
+static inline unsigned char *pool_at(const struct pool *p, const uint8_t i)
+{
+        return p->buf + (uint16_t) i * p->block;
+}
+
+/*******************************************************************************
+* chain every block to its successor, the last one links to the nblocks sentinel
+*/
+
+uint8_t pool_new(struct pool *p, unsigned char *buf, const uint8_t block,
+                 const uint8_t nblocks)
+{
+        if (!p || !buf) {
+                return POOL_NULL_INPUT;
+        }
+
+        if (block == 0 || nblocks == 0) {
+                return POOL_CAP_BOUNDS;
+        }
+
+        p->buf = buf;
+        p->block = block;
+        p->nblocks = nblocks;
+        p->head = 0;
+        p->used = 0;
+        p->hwm = 0;
+
+        for (uint8_t i = 0; i < nblocks; i++) {
+                *pool_at(p, i) = (uint8_t) (i + 1);
+        }
+
+        return POOL_SUCCESS;
+}
+
+/*******************************************************************************
+* pop the head of the free list
+*/
+
+uint8_t pool_acquire(struct pool *p, unsigned char **block)
+{
+        if (!p || !block) {
+                return POOL_NULL_INPUT;
+        }
+
+        if (pool_is_exhausted(*p)) {
+                return POOL_EXHAUSTED;
+        }
+
+        *block = pool_at(p, p->head);
+        p->head = **block;
+        p->used++;
+
+        if (p->used > p->hwm) {
+                p->hwm = p->used;
+        }
+
+        return POOL_SUCCESS;
+}
+
+/*******************************************************************************
+* validate the pointer then push it onto the head of the free list
+*/
+
+uint8_t pool_release(struct pool *p, unsigned char *block)
+{
+        if (!p || !block) {
+                return POOL_NULL_INPUT;
+        }
+
+        if (block < p->buf || p->used == 0) {
+                return POOL_BAD_BLOCK;
+        }
+
+        const ptrdiff_t offset = block - p->buf;
+
+        if (offset % p->block || offset / p->block >= p->nblocks) {
+                return POOL_BAD_BLOCK;
+        }
+
+        *block = p->head;
+        p->head = (uint8_t) (offset / p->block);
+        p->used--;
+
+        return POOL_SUCCESS;
+}
@@ -0,0 +1,101 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Fixed block pool allocator. The pool carves equal sized blocks out of one
+* caller-owned region, typically a static array, so deque base arrays can be
+* created and destroyed at runtime without a heap and without fragmentation.
+* Free blocks are chained through their own first byte, which holds the index
+* of the next free block, so the pool needs no bookkeeping array and acquire
+* and release are both O(1).
+*
+* usage:
+*       static unsigned char region[4 * 32];
+*       struct pool pool;
+*       pool_new(&pool, region, 32, 4);
+*
+*       unsigned char *buf;
+*       struct deque fifo;
+*       pool_acquire(&pool, &buf);
+*       deque_new(&fifo, buf, pool_block_size(pool));
+*       ...
+*       pool_release(&pool, buf);
+*/
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdint.h>
+
+/*******************************************************************************
+* API error codes
+* @POOL_CAP_BOUNDS: attempted to initialize pool with a zero block size or count
+* @POOL_NULL_INPUT: input argument is a null pointer
+* @POOL_EXHAUSTED: every block is in use
+* @POOL_BAD_BLOCK: released pointer is not the start of a block of this pool
+*******************************************************************************/
+#define POOL_SUCCESS            0
+#define POOL_CAP_BOUNDS         (uint8_t) '1'
+#define POOL_NULL_INPUT         (uint8_t) '2'
+#define POOL_EXHAUSTED          (uint8_t) '3'
+#define POOL_BAD_BLOCK          (uint8_t) '4'
+
+/*******************************************************************************
+* struct pool
+* @buf: base of the region
+* @block: size of each block in bytes
+* @nblocks: number of blocks in the region
+* @head: index of the first free block, nblocks when none are free
+* @used: number of blocks currently acquired
+* @hwm: high-water mark, the largest used since pool_new
+* note: all struct pool members are READ-ONLY
+*******************************************************************************/
+struct pool {
+        unsigned char *buf;
+        uint8_t block;
+        uint8_t nblocks;
+        uint8_t head;
+        uint8_t used;
+        uint8_t hwm;
+};
+
+/*******************************************************************************
+* pool_new() - initialize pool and mark every block free
+* @buf: region of at least block * nblocks bytes
+* @block: block size, 1 to 255
+* @nblocks: number of blocks, 1 to 255
+* Returns: error code POOL_SUCCESS else POOL_CAP_BOUNDS or POOL_NULL_INPUT
+* note: do not read/write directly to the region after pool_new returns, except
+* through the acquired blocks
+*******************************************************************************/
+uint8_t pool_new(struct pool *p, unsigned char *buf, const uint8_t block,
+                 const uint8_t nblocks);
+
+/*******************************************************************************
+* pool_acquire() - take a free block
+* @block: set to the start of the block
+* Returns: error code POOL_SUCCESS else POOL_NULL_INPUT or POOL_EXHAUSTED
+* note: the block contents are indeterminate
+*******************************************************************************/
+uint8_t pool_acquire(struct pool *p, unsigned char **block);
+
+/*******************************************************************************
+* pool_release() - return a block to the pool
+* @block: pointer previously set by pool_acquire()
+* Returns: error code POOL_SUCCESS else POOL_NULL_INPUT or POOL_BAD_BLOCK
+* note: releasing a block twice is only detected when no block is in use,
+* otherwise it corrupts the free list
+*******************************************************************************/
+uint8_t pool_release(struct pool *p, unsigned char *block);
+
+/*******************************************************************************
+* helper macros
+* note: macros expect a struct pool, not a reference to a struct pool
+* note: the pool is not interrupt safe. Acquire and release from one context,
+* or wrap the calls in an ATOMIC_BLOCK.
+*******************************************************************************/
+#define pool_block_size(p) ((p).block)
+#define pool_used(p) ((p).used)
+#define pool_hwm(p) ((p).hwm)
+#define pool_is_exhausted(p) ((p).head == (p).nblocks)
+
+#endif /* POOL_H */
@@ -0,0 +1,113 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Binary min-heap priority queue implementation. The children of node i are at
+* 2i + 1 and 2i + 2, computed in 16 bits since they can exceed 255.
+*/
+
+#include "pqueue.h"
+
+/******************************************************************************/
+
+uint8_t pqueue_new(struct pqueue *pq, struct pqueue_entry *heap,
+                   const uint8_t cap)
+{
+        if (!pq || !heap) {
+                return PQUEUE_NULL_INPUT;
+        }
+
+        if (cap == 0) {
+                return PQUEUE_CAP_BOUNDS;
+        }
+
+        pq->cap = cap;
+        pq->len = 0;
+        pq->heap = heap;
+
+        return PQUEUE_SUCCESS;
+}
+
+/*******************************************************************************
+* sift up. The hole moves toward the root while its parent is later than the new
+* key, and the new entry is written once at the final position.
+*/
+
+uint8_t pqueue_push(struct pqueue *pq, const pqueue_key key,
+                    const uint8_t value)
+{
+        if (!pq) {
+                return PQUEUE_NULL_INPUT;
+        }
+
+        if (pqueue_is_full(*pq)) {
+                return PQUEUE_FULL;
+        }
+
+        uint8_t i = pq->len++;
+
+        while (i) {
+                const uint8_t parent = (uint8_t) ((i - 1) >> 1);
+
+                if (!pqueue_before(key, pq->heap[parent].key)) {
+                        break;
+                }
+
+                pq->heap[i] = pq->heap[parent];
+                i = parent;
+        }
+
+        pq->heap[i].key = key;
+        pq->heap[i].value = value;
+
+        return PQUEUE_SUCCESS;
+}
+
+/*******************************************************************************
+* sift down. The last entry is reinserted at the root hole, which moves toward
+* the leaves while either child is earlier than it.
+*/
+
+uint8_t pqueue_pop(struct pqueue *pq, pqueue_key *key, uint8_t *value)
+{
+        if (!pq || !value) {
+                return PQUEUE_NULL_INPUT;
+        }
+
+        if (pqueue_is_empty(*pq)) {
+                return PQUEUE_EMPTY;
+        }
+
+        if (key) {
+                *key = pq->heap[0].key;
+        }
+
+        *value = pq->heap[0].value;
+
+        const struct pqueue_entry last = pq->heap[--pq->len];
+        const uint8_t len = pq->len;
+        uint8_t i = 0;
+
+        while (1) {
+                uint16_t child = (uint16_t) (2 * i + 1);
+
+                if (child >= len) {
+                        break;
+                }
+
+                if (child + 1 < len && pqueue_before(pq->heap[child + 1].key,
+                                                     pq->heap[child].key)) {
+                        child++;
+                }
+
+                if (!pqueue_before(pq->heap[child].key, last.key)) {
+                        break;
+                }
+
+                pq->heap[i] = pq->heap[child];
+                i = (uint8_t) child;
+        }
+
+        pq->heap[i] = last;
+
+        return PQUEUE_SUCCESS;
+}
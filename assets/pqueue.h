@@ -0,0 +1,113 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Binary min-heap priority queue keyed on a deadline. Entries pair a key, e.g. a
+* timer tick at which an event is due, with a one byte value identifying the
+* event. Insert and pop-min are both O(log n). Like the deque, the heap is
+* constructed over a caller-owned base array and does not use any dynamic
+* allocation.
+*
+* Keys are compared as differences, not magnitudes, so a free-running tick
+* counter may wrap through zero: key a is earlier than key b when the signed
+* difference a - b is negative. This holds as long as every pending key lies
+* within half the key range of every other, i.e. 32767 ticks for 16-bit keys.
+*/
+
+#ifndef PQUEUE_H
+#define PQUEUE_H
+
+#include <stdint.h>
+
+/*******************************************************************************
+* build profile
+* @PQUEUE_KEY32: define to use 32-bit keys, e.g. for a millisecond counter that
+* must schedule further ahead than 32 seconds. Each entry then takes 5 bytes of
+* SRAM instead of 3 and every comparison is 32-bit.
+*******************************************************************************/
+#ifdef PQUEUE_KEY32
+        typedef uint32_t pqueue_key;
+        typedef int32_t pqueue_diff;
+#else
+        typedef uint16_t pqueue_key;
+        typedef int16_t pqueue_diff;
+#endif
+
+/*******************************************************************************
+* API error codes
+* @PQUEUE_CAP_BOUNDS: attempted to initialize heap with zero capacity
+* @PQUEUE_NULL_INPUT: input argument is a null pointer
+* @PQUEUE_FULL: attempted to push an entry onto a full heap
+* @PQUEUE_EMPTY: attempted to pop an entry off an empty heap
+*******************************************************************************/
+#define PQUEUE_SUCCESS          0
+#define PQUEUE_CAP_BOUNDS       (uint8_t) '1'
+#define PQUEUE_NULL_INPUT       (uint8_t) '2'
+#define PQUEUE_FULL             (uint8_t) '3'
+#define PQUEUE_EMPTY            (uint8_t) '4'
+
+/*******************************************************************************
+* struct pqueue_entry
+* @key: deadline, the entry with the earliest key is popped first
+* @value: caller data, e.g. an index into a table of event handlers
+*******************************************************************************/
+struct pqueue_entry {
+        pqueue_key key;
+        uint8_t value;
+};
+
+/*******************************************************************************
+* struct pqueue
+* @cap: maximum capacity
+* @len: current size
+* @heap: base array in heap order, heap[0] holds the earliest key
+* note: all struct pqueue members are READ-ONLY
+*******************************************************************************/
+struct pqueue {
+        uint8_t cap;
+        uint8_t len;
+        struct pqueue_entry *heap;
+};
+
+/*******************************************************************************
+* pqueue_new() - initialize priority queue
+* @heap: base array
+* @cap: length of base array
+* Returns: error code PQUEUE_SUCCESS else PQUEUE_CAP_BOUNDS or PQUEUE_NULL_INPUT
+*******************************************************************************/
+uint8_t pqueue_new(struct pqueue *pq, struct pqueue_entry *heap,
+                   const uint8_t cap);
+
+/*******************************************************************************
+* pqueue_push() - insert an entry
+* Returns: error code PQUEUE_SUCCESS else PQUEUE_NULL_INPUT or PQUEUE_FULL
+* note: entries with equal keys are popped in an unspecified order
+*******************************************************************************/
+uint8_t pqueue_push(struct pqueue *pq, const pqueue_key key,
+                    const uint8_t value);
+
+/*******************************************************************************
+* pqueue_pop() - remove the entry with the earliest key
+* @key: set to the key, may be null if not needed
+* @value: set to the value
+* Returns: error code PQUEUE_SUCCESS else PQUEUE_NULL_INPUT or PQUEUE_EMPTY
+*******************************************************************************/
+uint8_t pqueue_pop(struct pqueue *pq, pqueue_key *key, uint8_t *value);
+
+/*******************************************************************************
+* helper macros
+* note: macros expect a struct pqueue, not a reference to a struct pqueue
+* note: pqueue_peek_key and pqueue_peek_value are only meaningful when the heap
+* is not empty
+*******************************************************************************/
+#define pqueue_is_full(pq) ((pq).cap == (pq).len)
+#define pqueue_is_not_full(pq) (!((pq).cap == (pq).len))
+
+#define pqueue_is_empty(pq) ((pq).len == 0)
+#define pqueue_is_not_empty(pq) (!((pq).len == 0))
+
+#define pqueue_peek_key(pq) ((pq).heap[0].key)
+#define pqueue_peek_value(pq) ((pq).heap[0].value)
+
+#define pqueue_before(a, b) ((pqueue_diff) ((pqueue_key) ((a) - (b))) < 0)
+
+#endif /* PQUEUE_H */
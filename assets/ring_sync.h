@@ -0,0 +1,48 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Index publication for the lock-free rings (spsc.c, bcast.c). A context reads
+* another context's index with acquire semantics and publishes its own index
+* with release semantics, so the element copy can never be reordered past the
+* index update that hands it over.
+*
+* On AVR, single byte loads and stores are atomic and the core does not reorder
+* memory accesses, so only the compiler has to be fenced. The __atomic builtins
+* are avoided there because avr-gcc lowers them to libatomic calls that avr-libc
+* does not provide. Hosted builds (the unit tests) run on weakly ordered cores
+* and use the builtins.
+*/
+
+#ifndef RING_SYNC_H
+#define RING_SYNC_H
+
+#include <stdint.h>
+
+#ifdef __AVR__
+        #define barrier() __asm__ __volatile__ ("" ::: "memory")
+
+        static inline uint8_t load_acquire(const volatile uint8_t *src)
+        {
+                const uint8_t val = *src;
+                barrier();
+                return val;
+        }
+
+        static inline void store_release(volatile uint8_t *dst, uint8_t val)
+        {
+                barrier();
+                *dst = val;
+        }
+#else
+        static inline uint8_t load_acquire(const volatile uint8_t *src)
+        {
+                return __atomic_load_n(src, __ATOMIC_ACQUIRE);
+        }
+
+        static inline void store_release(volatile uint8_t *dst, uint8_t val)
+        {
+                __atomic_store_n(dst, val, __ATOMIC_RELEASE);
+        }
+#endif
+
+#endif /* RING_SYNC_H */
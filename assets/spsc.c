@@ -0,0 +1,76 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Single producer single consumer ring implementation
+*/
+
+#include "ring_sync.h"
+#include "spsc.h"
+
+/******************************************************************************/
+
+uint8_t spsc_new(struct spsc *q, unsigned char *buf, const uint8_t cap)
+{
+        if (!q || !buf) {
+                return SPSC_NULL_INPUT;
+        }
+
+        if (cap == 0 || cap > 128 || (cap & (cap - 1))) {
+                return SPSC_CAP_BOUNDS;
+        }
+
+        q->mask = (uint8_t) (cap - 1);
+        q->head = 0;
+        q->tail = 0;
+        q->buf = buf;
+
+        return SPSC_SUCCESS;
+}
+
+/*******************************************************************************
+* the producer owns head, so a plain read of it is always current. The tail may
+* move concurrently but only toward more free space.
+*/
+
+uint8_t spsc_push(struct spsc *q, const unsigned char data)
+{
+        if (!q) {
+                return SPSC_NULL_INPUT;
+        }
+
+        const uint8_t head = q->head;
+        const uint8_t tail = load_acquire(&q->tail);
+
+        if ((uint8_t) (head - tail) > q->mask) {
+                return SPSC_FULL;
+        }
+
+        q->buf[head & q->mask] = data;
+        store_release(&q->head, (uint8_t) (head + 1));
+
+        return SPSC_SUCCESS;
+}
+
+/*******************************************************************************
+* the consumer owns tail, so a plain read of it is always current. The head may
+* move concurrently but only toward more data.
+*/
+
+uint8_t spsc_pop(struct spsc *q, unsigned char *data)
+{
+        if (!q || !data) {
+                return SPSC_NULL_INPUT;
+        }
+
+        const uint8_t tail = q->tail;
+        const uint8_t head = load_acquire(&q->head);
+
+        if (head == tail) {
+                return SPSC_EMPTY;
+        }
+
+        *data = q->buf[tail & q->mask];
+        store_release(&q->tail, (uint8_t) (tail + 1));
+
+        return SPSC_SUCCESS;
+}
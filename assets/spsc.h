@@ -0,0 +1,78 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Single producer single consumer ring for unsigned char data. One context (e.g.
+* a receive ISR) pushes and one other context (e.g. main) pops without masking
+* interrupts. The producer only ever writes the head index and the consumer only
+* ever writes the tail index, so there is no shared read-modify-write. Like the
+* deque, the ring is constructed over a caller-owned base array and does not
+* use any dynamic allocation.
+*/
+
+#ifndef SPSC_H
+#define SPSC_H
+
+#include <stdint.h>
+
+/*******************************************************************************
+* API error codes
+* @SPSC_CAP_BOUNDS: capacity is not a power of two within 1 to 128
+* @SPSC_NULL_INPUT: input argument is a null pointer
+* @SPSC_FULL: attempted to push data onto a full ring
+* @SPSC_EMPTY: attempted to pop data off an empty ring
+*******************************************************************************/
+#define SPSC_SUCCESS            0
+#define SPSC_CAP_BOUNDS         (uint8_t) '1'
+#define SPSC_NULL_INPUT         (uint8_t) '2'
+#define SPSC_FULL               (uint8_t) '3'
+#define SPSC_EMPTY              (uint8_t) '4'
+
+/*******************************************************************************
+* struct spsc
+* @mask: capacity - 1
+* @head: free-running count of pushes, written by the producer only
+* @tail: free-running count of pops, written by the consumer only
+* @buf: base array
+* note: all struct spsc members are READ-ONLY
+* note: head and tail wrap at 256, which is why the capacity is limited to a
+* power of two no larger than 128. The occupancy is always head - tail.
+*******************************************************************************/
+struct spsc {
+        uint8_t mask;
+        volatile uint8_t head;
+        volatile uint8_t tail;
+        unsigned char *buf;
+};
+
+/*******************************************************************************
+* spsc_new() - initialize single producer single consumer ring
+* @buf: base array
+* @cap: length of base array, a power of two from 1 to 128
+* Returns: error code SPSC_SUCCESS else SPSC_CAP_BOUNDS or SPSC_NULL_INPUT
+* note: call before either context starts using the ring
+*******************************************************************************/
+uint8_t spsc_new(struct spsc *q, unsigned char *buf, const uint8_t cap);
+
+/*******************************************************************************
+* spsc_push() - producer side only
+* Returns: error code SPSC_SUCCESS else SPSC_NULL_INPUT or SPSC_FULL
+*******************************************************************************/
+uint8_t spsc_push(struct spsc *q, const unsigned char data);
+
+/*******************************************************************************
+* spsc_pop() - consumer side only
+* Returns: error code SPSC_SUCCESS else SPSC_NULL_INPUT or SPSC_EMPTY
+*******************************************************************************/
+uint8_t spsc_pop(struct spsc *q, unsigned char *data);
+
+/*******************************************************************************
+* helper macros
+* note: macros expect a struct spsc, not a reference to a struct spsc
+* note: the result is a snapshot. It can only grow (len) or shrink (free) when
+* read from the consumer, and the reverse when read from the producer.
+*******************************************************************************/
+#define spsc_len(q) ((uint8_t) ((q).head - (q).tail))
+#define spsc_is_empty(q) ((q).head == (q).tail)
+#define spsc_is_full(q) (spsc_len(q) == (uint8_t) ((q).mask + 1))
+
+#endif /* SPSC_H */
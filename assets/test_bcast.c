@@ -0,0 +1,217 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Unit tests for single producer multiple reader broadcast ring
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+
+#include "bcast.h"
+#include "unity.h"
+
+void test_new_bcast_non_power_of_two_capacity_returns_error(void) {
+        //arrange
+        struct bcast b;
+        uint8_t err;
+        volatile uint8_t tails[2];
+        unsigned char buf[12];
+
+        //act
+        err = bcast_new(&b, buf, sizeof(buf), tails, 2);
+
+        //assert
+        TEST_ASSERT_EQUAL(BCAST_CAP_BOUNDS, err);
+}
+
+void test_new_bcast_zero_readers_returns_error(void) {
+        //arrange
+        struct bcast b;
+        uint8_t err;
+        volatile uint8_t tails[1];
+        unsigned char buf[8];
+
+        //act
+        err = bcast_new(&b, buf, sizeof(buf), tails, 0);
+
+        //assert
+        TEST_ASSERT_EQUAL(BCAST_READER_BOUNDS, err);
+}
+
+void test_new_bcast_null_cursor_array_returns_error(void) {
+        //arrange
+        struct bcast b;
+        uint8_t err;
+        unsigned char buf[8];
+
+        //act
+        err = bcast_new(&b, buf, sizeof(buf), NULL, 2);
+
+        //assert
+        TEST_ASSERT_EQUAL(BCAST_NULL_INPUT, err);
+}
+
+void test_bcast_every_reader_sees_every_byte(void) {
+        //arrange
+        struct bcast b;
+        uint8_t err;
+        unsigned char data;
+        volatile uint8_t tails[3];
+        unsigned char buf[8];
+
+        //act
+        bcast_new(&b, buf, sizeof(buf), tails, 3);
+
+        for (uint8_t i = 0; i < 8; i++) {
+                bcast_push(&b, i);
+        }
+
+        //assert
+        for (uint8_t r = 0; r < 3; r++) {
+                TEST_ASSERT_EQUAL_UINT8(8, bcast_len(b, r));
+
+                for (uint8_t i = 0; i < 8; i++) {
+                        err = bcast_pop(&b, r, &data);
+                        TEST_ASSERT_EQUAL(BCAST_SUCCESS, err);
+                        TEST_ASSERT_EQUAL_UINT8(i, data);
+                }
+
+                TEST_ASSERT_EQUAL(BCAST_EMPTY, bcast_pop(&b, r, &data));
+        }
+}
+
+void test_bcast_slowest_reader_limits_free_space(void) {
+        //arrange
+        struct bcast b;
+        uint8_t err_0;
+        uint8_t err_1;
+        unsigned char data;
+        volatile uint8_t tails[2];
+        unsigned char buf[4];
+
+        //act
+        bcast_new(&b, buf, sizeof(buf), tails, 2);
+
+        for (uint8_t i = 0; i < 4; i++) {
+                bcast_push(&b, i);
+                bcast_pop(&b, 0, &data);
+        }
+
+        err_0 = bcast_push(&b, 4);
+        bcast_pop(&b, 1, &data);
+        err_1 = bcast_push(&b, 4);
+
+        //assert
+        TEST_ASSERT_EQUAL(BCAST_FULL, err_0);
+        TEST_ASSERT_EQUAL(BCAST_SUCCESS, err_1);
+        TEST_ASSERT_EQUAL_UINT8(1, bcast_len(b, 0));
+        TEST_ASSERT_EQUAL_UINT8(4, bcast_len(b, 1));
+}
+
+void test_bcast_pop_with_unknown_reader_returns_error(void) {
+        //arrange
+        struct bcast b;
+        uint8_t err;
+        unsigned char data;
+        volatile uint8_t tails[2];
+        unsigned char buf[4];
+
+        //act
+        bcast_new(&b, buf, sizeof(buf), tails, 2);
+        bcast_push(&b, 42);
+        err = bcast_pop(&b, 2, &data);
+
+        //assert
+        TEST_ASSERT_EQUAL(BCAST_READER_BOUNDS, err);
+}
+
+/*******************************************************************************
+* stress test. One producer and three readers run on separate threads over a
+* small ring, see test_spsc.c. Every reader must receive the full sequence.
+*/
+
+#define STRESS_COUNT 200000UL
+#define STRESS_READERS 3
+
+static struct bcast stress_b;
+static unsigned char stress_buf[8];
+static volatile uint8_t stress_tails[STRESS_READERS];
+static unsigned long stress_errors[STRESS_READERS];
+static uint8_t stress_ids[STRESS_READERS] = {0, 1, 2};
+
+static void *stress_producer(void *arg) {
+        (void) arg;
+
+        for (unsigned long i = 0; i < STRESS_COUNT; i++) {
+                while (bcast_push(&stress_b, (unsigned char) i) == BCAST_FULL) {
+                        sched_yield();
+                }
+        }
+
+        return NULL;
+}
+
+static void *stress_reader(void *arg) {
+        const uint8_t r = *(uint8_t *) arg;
+        unsigned char data;
+
+        for (unsigned long i = 0; i < STRESS_COUNT; i++) {
+                while (bcast_pop(&stress_b, r, &data) == BCAST_EMPTY) {
+                        sched_yield();
+                }
+
+                if (data != (unsigned char) i) {
+                        stress_errors[r]++;
+                }
+        }
+
+        return NULL;
+}
+
+void test_bcast_multi_thread_stress(void) {
+        //arrange
+        pthread_t producer;
+        pthread_t readers[STRESS_READERS];
+
+        bcast_new(&stress_b, stress_buf, sizeof(stress_buf), stress_tails,
+                  STRESS_READERS);
+
+        //act
+        for (uint8_t r = 0; r < STRESS_READERS; r++) {
+                pthread_create(&readers[r], NULL, stress_reader, &stress_ids[r]);
+        }
+
+        pthread_create(&producer, NULL, stress_producer, NULL);
+        pthread_join(producer, NULL);
+
+        for (uint8_t r = 0; r < STRESS_READERS; r++) {
+                pthread_join(readers[r], NULL);
+        }
+
+        //assert
+        for (uint8_t r = 0; r < STRESS_READERS; r++) {
+                TEST_ASSERT_EQUAL_UINT32(0, stress_errors[r]);
+                TEST_ASSERT_TRUE(bcast_is_empty(stress_b, r));
+        }
+}
+
+int main(void)
+{
+        UNITY_BEGIN();
+
+        //initialization tests
+        RUN_TEST(test_new_bcast_non_power_of_two_capacity_returns_error);
+        RUN_TEST(test_new_bcast_zero_readers_returns_error);
+        RUN_TEST(test_new_bcast_null_cursor_array_returns_error);
+
+        //single thread
+        RUN_TEST(test_bcast_every_reader_sees_every_byte);
+        RUN_TEST(test_bcast_slowest_reader_limits_free_space);
+        RUN_TEST(test_bcast_pop_with_unknown_reader_returns_error);
+
+        //multiple threads
+        RUN_TEST(test_bcast_multi_thread_stress);
+
+        return UNITY_END();
+}
@@ -0,0 +1,202 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Unit tests for single bit double ended queue
+*/
+
+#include <stdint.h>
+
+#include "bitdeque.h"
+#include "unity.h"
+
+void test_new_bitdeque_zero_capacity_returns_error(void) {
+        //arrange
+        struct bitdeque bq;
+        uint8_t err;
+        unsigned char buf[1];
+
+        //act
+        err = bitdeque_new(&bq, buf, 0);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_CAP_BOUNDS, err);
+}
+
+void test_new_bitdeque_capacity_is_eight_bits_per_byte(void) {
+        //arrange
+        struct bitdeque bq;
+        uint8_t err;
+        unsigned char buf[255];
+
+        //act
+        err = bitdeque_new(&bq, buf, sizeof(buf));
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err);
+        TEST_ASSERT_EQUAL_UINT16(2040, bq.cap);
+        TEST_ASSERT_TRUE(bitdeque_is_empty(bq));
+}
+
+void test_bitdeque_fifo_fills_to_capacity_and_wraps(void) {
+        //arrange
+        struct bitdeque bq;
+        uint8_t err;
+        uint8_t bit;
+        unsigned char buf[3];
+
+        //act
+        bitdeque_new(&bq, buf, sizeof(buf));
+
+        //act-assert
+        for (uint8_t pass = 0; pass < 5; pass++) {
+                for (uint8_t i = 0; i < 24; i++) {
+                        err = bitdeque_push_back(&bq, (i + pass) % 3 == 0);
+                        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err);
+                }
+
+                TEST_ASSERT_TRUE(bitdeque_is_full(bq));
+                TEST_ASSERT_EQUAL(DEQUE_FULL, bitdeque_push_back(&bq, 1));
+
+                for (uint8_t i = 0; i < 24; i++) {
+                        err = bitdeque_pop_front(&bq, &bit);
+                        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err);
+                        TEST_ASSERT_EQUAL_UINT8((i + pass) % 3 == 0, bit);
+                }
+
+                //shift the start point off the byte boundary
+                bitdeque_push_back(&bq, 0);
+                bitdeque_pop_front(&bq, &bit);
+        }
+}
+
+void test_bitdeque_lifo_at_both_ends(void) {
+        //arrange
+        struct bitdeque bq;
+        uint8_t bit;
+        unsigned char buf[1];
+
+        //act
+        bitdeque_new(&bq, buf, sizeof(buf));
+        bitdeque_push_back(&bq, 1);
+        bitdeque_push_back(&bq, 0);
+        bitdeque_push_front(&bq, 0);
+        bitdeque_push_front(&bq, 1);
+
+        //assert
+        bitdeque_pop_back(&bq, &bit);
+        TEST_ASSERT_EQUAL_UINT8(0, bit);
+        bitdeque_pop_back(&bq, &bit);
+        TEST_ASSERT_EQUAL_UINT8(1, bit);
+        bitdeque_pop_front(&bq, &bit);
+        TEST_ASSERT_EQUAL_UINT8(1, bit);
+        bitdeque_pop_front(&bq, &bit);
+        TEST_ASSERT_EQUAL_UINT8(0, bit);
+        TEST_ASSERT_EQUAL(DEQUE_EMPTY, bitdeque_pop_front(&bq, &bit));
+}
+
+void test_bitdeque_nonzero_push_is_stored_as_one(void) {
+        //arrange
+        struct bitdeque bq;
+        uint8_t bit;
+        unsigned char buf[1];
+
+        //act
+        bitdeque_new(&bq, buf, sizeof(buf));
+        bitdeque_push_back(&bq, 0x80);
+        bitdeque_pop_back(&bq, &bit);
+
+        //assert
+        TEST_ASSERT_EQUAL_UINT8(1, bit);
+}
+
+void test_bitdeque_aligned_bulk_round_trip_across_wrap(void) {
+        //arrange
+        struct bitdeque bq;
+        uint8_t err;
+        unsigned char src[3] = {0xA5, 0x3C, 0x0F};
+        unsigned char dst[3];
+        unsigned char buf[4];
+
+        //act
+        bitdeque_new(&bq, buf, sizeof(buf));
+        bitdeque_push_back_n(&bq, src, 2);
+        bitdeque_pop_front_n(&bq, dst, 2);
+        err = bitdeque_push_back_n(&bq, src, sizeof(src));
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err);
+        TEST_ASSERT_EQUAL_UINT16(24, bq.len);
+        TEST_ASSERT_EQUAL(DEQUE_FULL, bitdeque_push_back_n(&bq, src, 2));
+
+        err = bitdeque_pop_front_n(&bq, dst, sizeof(dst));
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(src, dst, sizeof(src));
+}
+
+void test_bitdeque_unaligned_bulk_matches_single_bits(void) {
+        //arrange
+        struct bitdeque bq;
+        uint8_t bit;
+        unsigned char src[2] = {0x81, 0x7E};
+        unsigned char dst[2];
+        unsigned char buf[3];
+
+        //act
+        bitdeque_new(&bq, buf, sizeof(buf));
+        bitdeque_push_back(&bq, 1);
+        bitdeque_push_back(&bq, 0);
+        bitdeque_push_back(&bq, 1);
+        bitdeque_push_back_n(&bq, src, sizeof(src));
+
+        //assert
+        for (uint8_t i = 0; i < 3; i++) {
+                bitdeque_pop_front(&bq, &bit);
+                TEST_ASSERT_EQUAL_UINT8(i % 2 == 0, bit);
+        }
+
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, bitdeque_pop_front_n(&bq, dst, 2));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(src, dst, sizeof(src));
+        TEST_ASSERT_TRUE(bitdeque_is_empty(bq));
+}
+
+void test_bitdeque_bulk_pop_larger_than_len_returns_error(void) {
+        //arrange
+        struct bitdeque bq;
+        uint8_t err;
+        unsigned char dst[1];
+        unsigned char buf[2];
+
+        //act
+        bitdeque_new(&bq, buf, sizeof(buf));
+
+        for (uint8_t i = 0; i < 7; i++) {
+                bitdeque_push_back(&bq, 1);
+        }
+
+        err = bitdeque_pop_front_n(&bq, dst, 1);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_EMPTY, err);
+        TEST_ASSERT_EQUAL_UINT16(7, bq.len);
+}
+
+int main(void)
+{
+        UNITY_BEGIN();
+
+        //initialization tests
+        RUN_TEST(test_new_bitdeque_zero_capacity_returns_error);
+        RUN_TEST(test_new_bitdeque_capacity_is_eight_bits_per_byte);
+
+        //single bit operations
+        RUN_TEST(test_bitdeque_fifo_fills_to_capacity_and_wraps);
+        RUN_TEST(test_bitdeque_lifo_at_both_ends);
+        RUN_TEST(test_bitdeque_nonzero_push_is_stored_as_one);
+
+        //bulk operations
+        RUN_TEST(test_bitdeque_aligned_bulk_round_trip_across_wrap);
+        RUN_TEST(test_bitdeque_unaligned_bulk_matches_single_bits);
+        RUN_TEST(test_bitdeque_bulk_pop_larger_than_len_returns_error);
+
+        return UNITY_END();
+}
@@ -6,9 +6,52 @@
 
 #include <stdint.h>
 
-#include "deque.h"
 #include "unity.h"
 
+/*******************************************************************************
+* The same suite runs against struct deque16 when TEST_DEQUE16 is defined. The
+* struct deque API is mapped onto the 16-bit names and the span length type is
+* widened. Tests for 16-bit specific capacities are at the end of the file.
+*/
+
+#ifdef TEST_DEQUE16
+        #include "deque16.h"
+
+        #undef deque_is_full
+        #undef deque_is_not_full
+        #undef deque_is_empty
+        #undef deque_is_not_empty
+        #undef deque_peek_back
+        #undef deque_peek_front
+
+        #define deque deque16
+        #define deque_new deque16_new
+        #define deque_push_back deque16_push_back
+        #define deque_pop_back deque16_pop_back
+        #define deque_push_front deque16_push_front
+        #define deque_pop_front deque16_pop_front
+        #define deque_push_back_n deque16_push_back_n
+        #define deque_pop_back_n deque16_pop_back_n
+        #define deque_push_front_n deque16_push_front_n
+        #define deque_pop_front_n deque16_pop_front_n
+        #define deque_write_span deque16_write_span
+        #define deque_commit deque16_commit
+        #define deque_read_span deque16_read_span
+        #define deque_release deque16_release
+        #define deque_is_full deque16_is_full
+        #define deque_is_not_full deque16_is_not_full
+        #define deque_is_empty deque16_is_empty
+        #define deque_is_not_empty deque16_is_not_empty
+        #define deque_peek_back deque16_peek_back
+        #define deque_peek_front deque16_peek_front
+
+        typedef uint16_t span_len;
+#else
+        #include "deque.h"
+
+        typedef uint8_t span_len;
+#endif
+
 void test_new_deque_zero_capacity_returns_error(void) {
         //arrange
         struct deque dq;
@@ -23,6 +66,10 @@ void test_new_deque_zero_capacity_returns_error(void) {
 }
 
 void test_new_deque_null_buffer_returns_error(void) {
+#ifdef DEQUE_UNCHECKED
+        TEST_IGNORE_MESSAGE("null checks removed by DEQUE_UNCHECKED");
+#endif
+
         //arrange
         struct deque dq;
         uint8_t err;
@@ -53,7 +100,7 @@ void test_max_push_back_then_pop_back_returns_correct_data(void) {
         uint8_t err_0;
         uint8_t err_1;
         uint8_t err_2;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[255];
 
         //act
@@ -74,7 +121,7 @@ void test_max_push_front_then_pop_front_returns_correct_data(void) {
         uint8_t err_0;
         uint8_t err_1;
         uint8_t err_2;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[255];
 
         //act
@@ -95,7 +142,7 @@ void test_max_push_back_then_pop_front_returns_correct_data(void) {
         uint8_t err_0;
         uint8_t err_1;
         uint8_t err_2;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[255];
 
         //act
@@ -116,7 +163,7 @@ void test_max_push_front_then_pop_back_returns_correct_data(void) {
         uint8_t err_0;
         uint8_t err_1;
         uint8_t err_2;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[255];
 
         //act
@@ -137,7 +184,7 @@ void test_singleton_push_back_then_pop_back_returns_correct_data(void) {
         uint8_t err_0;
         uint8_t err_1;
         uint8_t err_2;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[1];
 
         //act
@@ -158,7 +205,7 @@ void test_singleton_push_front_then_pop_front_returns_correct_data(void) {
         uint8_t err_0;
         uint8_t err_1;
         uint8_t err_2;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[1];
 
         //act
@@ -179,7 +226,7 @@ void test_singleton_push_back_then_pop_front_returns_correct_data(void) {
         uint8_t err_0;
         uint8_t err_1;
         uint8_t err_2;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[1];
 
         //act
@@ -200,7 +247,7 @@ void test_singleton_push_front_then_pop_back_returns_correct_data(void) {
         uint8_t err_0;
         uint8_t err_1;
         uint8_t err_2;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[1];
 
         //act
@@ -221,7 +268,7 @@ void test_mid_push_back_then_pop_back_returns_correct_data(void) {
         uint8_t err_0;
         uint8_t err_1;
         uint8_t err_2;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[129];
 
         //act
@@ -242,7 +289,7 @@ void test_mid_push_front_then_pop_front_returns_correct_data(void) {
         uint8_t err_0;
         uint8_t err_1;
         uint8_t err_2;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[129];
 
         //act
@@ -263,7 +310,7 @@ void test_mid_push_back_then_pop_front_returns_correct_data(void) {
         uint8_t err_0;
         uint8_t err_1;
         uint8_t err_2;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[129];
 
         //act
@@ -284,7 +331,7 @@ void test_mid_push_front_then_pop_back_returns_correct_data(void) {
         uint8_t err_0;
         uint8_t err_1;
         uint8_t err_2;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[129];
 
         //act
@@ -342,7 +389,7 @@ void test_pop_back_on_empty_array_returns_error(void) {
         struct deque dq;
         uint8_t err_0;
         uint8_t err_1;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[1];
 
         //act
@@ -359,7 +406,7 @@ void test_pop_front_on_empty_array_returns_error(void) {
         struct deque dq;
         uint8_t err_0;
         uint8_t err_1;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[1];
 
         //act
@@ -375,7 +422,7 @@ void test_deque_made_empty_is_truly_empty_via_pop_back(void) {
         //arrange
         struct deque dq;
         uint8_t err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[2];
 
         //act
@@ -394,7 +441,7 @@ void test_deque_made_empty_is_truly_empty_via_pop_front(void) {
         //arrange
         struct deque dq;
         uint8_t err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[2];
 
         //act
@@ -495,7 +542,7 @@ void test_max_lifo_push_then_pop_iteration_back(void) {
         //arrange
         struct deque dq;
         int err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[255];
 
         //act
@@ -515,7 +562,7 @@ void test_mid_lifo_push_then_pop_iteration_back(void) {
         //arrange
         struct deque dq;
         int err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[129];
 
         //act
@@ -535,7 +582,7 @@ void test_singleton_lifo_push_then_pop_iteration_back(void) {
         //arrange
         struct deque dq;
         int err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[1];
 
         //act
@@ -555,7 +602,7 @@ void test_lifo_fill_completely_then_purge_back(void) {
         //arrange
         struct deque dq;
         int err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[255];
 
         //act
@@ -577,7 +624,7 @@ void test_lifo_fill_completely_then_purge_and_repeat_back(void) {
         //arrange
         struct deque dq;
         int err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[255];
 
         //act
@@ -609,7 +656,7 @@ void test_max_lifo_push_then_pop_iteration_front(void) {
         //arrange
         struct deque dq;
         int err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[255];
 
         //act
@@ -629,7 +676,7 @@ void test_mid_lifo_push_then_pop_iteration_front(void) {
         //arrange
         struct deque dq;
         int err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[129];
 
         //act
@@ -649,7 +696,7 @@ void test_singleton_lifo_push_then_pop_iteration_front(void) {
         //arrange
         struct deque dq;
         int err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[1];
 
         //act
@@ -669,7 +716,7 @@ void test_lifo_fill_completely_then_purge_front(void) {
         //arrange
         struct deque dq;
         int err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[255];
 
         //act
@@ -691,7 +738,7 @@ void test_lifo_fill_completely_then_purge_and_repeat_front(void) {
         //arrange
         struct deque dq;
         int err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[255];
 
         //act
@@ -723,7 +770,7 @@ void test_mixed_max_push_back_pop_front_iteration(void) {
         //arrange
         struct deque dq;
         int err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[255];
 
         //act
@@ -742,7 +789,7 @@ void test_mixed_mid_push_back_pop_front_iteration(void) {
         //arrange
         struct deque dq;
         int err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[129];
 
         //act
@@ -761,7 +808,7 @@ void test_mixed_singleton_push_back_pop_front_iteration(void) {
         //arrange
         struct deque dq;
         int err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[1];
 
         //act
@@ -780,7 +827,7 @@ void test_mixed_max_push_front_pop_back_iteration(void) {
         //arrange
         struct deque dq;
         int err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[255];
 
         //act
@@ -799,7 +846,7 @@ void test_mixed_mid_push_front_pop_back_iteration(void) {
         //arrange
         struct deque dq;
         int err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[129];
 
         //act
@@ -818,7 +865,7 @@ void test_mixed_singleton_push_front_pop_back_iteration(void) {
         //arrange
         struct deque dq;
         int err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[1];
 
         //act
@@ -837,7 +884,7 @@ void test_fifo_fill_completely_then_purge_back(void) {
         //arrange
         struct deque dq;
         int err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[255];
 
         //act
@@ -859,7 +906,7 @@ void test_fifo_fill_completely_then_purge_and_repeat_back(void) {
         //arrange
         struct deque dq;
         int err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[255];
 
         //act
@@ -890,7 +937,7 @@ void test_fifo_fill_completely_then_purge_front(void) {
         //arrange
         struct deque dq;
         int err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[255];
 
         //act
@@ -912,7 +959,7 @@ void test_fifo_fill_completely_then_purge_and_repeat_front(void) {
         //arrange
         struct deque dq;
         int err;
-        unsigned char data;
+        unsigned char data = 0;
         unsigned char buf[255];
 
         //act
@@ -938,76 +985,1322 @@ void test_fifo_fill_completely_then_purge_and_repeat_front(void) {
         }
 }
 
-int main(void)
-{
-        UNITY_BEGIN();
+/******************************************************************************/
 
-        //initialization tests
-        RUN_TEST(test_new_deque_zero_capacity_returns_error);
-        RUN_TEST(test_new_deque_null_buffer_returns_error);
-        RUN_TEST(test_new_deque_with_legal_parameters_returns_success);
+void test_new_deque_power_of_two_capacity_sets_mask(void) {
+        //arrange
+        struct deque dq;
+        unsigned char buf[64];
 
-        //single-item max-element buffer
-        RUN_TEST(test_max_push_back_then_pop_back_returns_correct_data);
-        RUN_TEST(test_max_push_front_then_pop_front_returns_correct_data);
-        RUN_TEST(test_max_push_back_then_pop_front_returns_correct_data);
-        RUN_TEST(test_max_push_front_then_pop_back_returns_correct_data);
+        //act
+        deque_new(&dq, buf, sizeof(buf));
 
-        //single-item single-element buffer
-        RUN_TEST(test_singleton_push_back_then_pop_back_returns_correct_data);
-        RUN_TEST(test_singleton_push_front_then_pop_front_returns_correct_data);
-        RUN_TEST(test_singleton_push_back_then_pop_front_returns_correct_data);
-        RUN_TEST(test_singleton_push_front_then_pop_back_returns_correct_data);
+        //assert
+        TEST_ASSERT_EQUAL_UINT8(63, dq.mask);
+}
 
-        //single-item mid-size-element buffer
-        RUN_TEST(test_mid_push_back_then_pop_back_returns_correct_data);
-        RUN_TEST(test_mid_push_front_then_pop_front_returns_correct_data);
-        RUN_TEST(test_mid_push_back_then_pop_front_returns_correct_data);
-        RUN_TEST(test_mid_push_front_then_pop_back_returns_correct_data);
+void test_new_deque_other_capacity_clears_mask(void) {
+        //arrange
+        struct deque dq;
+        unsigned char buf[255];
 
-        //single-item error conditions
-        RUN_TEST(test_push_back_on_full_array_returns_error);
-        RUN_TEST(test_push_front_on_full_array_returns_error);
-        RUN_TEST(test_pop_back_on_empty_array_returns_error);
-        RUN_TEST(test_pop_front_on_empty_array_returns_error);
+        //act
+        deque_new(&dq, buf, sizeof(buf));
 
-        //check empty
-        RUN_TEST(test_deque_made_empty_is_truly_empty_via_pop_back);
-        RUN_TEST(test_deque_made_empty_is_truly_empty_via_pop_front);
+        //assert
+        TEST_ASSERT_EQUAL_UINT8(0, dq.mask);
+}
 
-        //helper macros
-        RUN_TEST(test_macro_deque_is_full);
-        RUN_TEST(test_macro_deque_is_not_full);
-        RUN_TEST(test_macro_deque_is_empty);
-        RUN_TEST(test_macro_deque_is_not_empty);
-        RUN_TEST(test_macro_deque_peek_back);
-        RUN_TEST(test_macro_deque_peek_front);
+void test_pow2_fifo_wraparound_back(void) {
+        //arrange
+        struct deque dq;
+        int err;
+        unsigned char data = 0;
+        unsigned char buf[64];
 
-        //lifo tests from stack side
-        RUN_TEST(test_max_lifo_push_then_pop_iteration_back);
-        RUN_TEST(test_mid_lifo_push_then_pop_iteration_back);
-        RUN_TEST(test_singleton_lifo_push_then_pop_iteration_back);
-        RUN_TEST(test_lifo_fill_completely_then_purge_back);
-        RUN_TEST(test_lifo_fill_completely_then_purge_and_repeat_back);
+        //act
+        deque_new(&dq, buf, 64);
 
-        //lifo tests from queue side
-        RUN_TEST(test_max_lifo_push_then_pop_iteration_front);
-        RUN_TEST(test_mid_lifo_push_then_pop_iteration_front);
-        RUN_TEST(test_singleton_lifo_push_then_pop_iteration_front);
-        RUN_TEST(test_lifo_fill_completely_then_purge_front);
-        RUN_TEST(test_lifo_fill_completely_then_purge_and_repeat_front);
+        for (uint8_t i = 0; i < 40; i++) {
+                deque_push_back(&dq, (unsigned char) i);
+                deque_pop_front(&dq, &data);
+        }
 
-        //fifo mix tests
-        RUN_TEST(test_mixed_max_push_back_pop_front_iteration);
-        RUN_TEST(test_mixed_mid_push_back_pop_front_iteration);
-        RUN_TEST(test_mixed_singleton_push_back_pop_front_iteration);
-        RUN_TEST(test_mixed_max_push_front_pop_back_iteration);
-        RUN_TEST(test_mixed_mid_push_front_pop_back_iteration);
-        RUN_TEST(test_mixed_singleton_push_front_pop_back_iteration);
-        RUN_TEST(test_fifo_fill_completely_then_purge_back);
-        RUN_TEST(test_fifo_fill_completely_then_purge_and_repeat_back);
-        RUN_TEST(test_fifo_fill_completely_then_purge_front);
-        RUN_TEST(test_fifo_fill_completely_then_purge_and_repeat_front);
+        for (uint8_t i = 0; i < 64; i++) {
+                deque_push_back(&dq, (unsigned char) i);
+        }
+
+        //assert
+        for (uint8_t i = 0; i < 64; i++) {
+                err = deque_pop_front(&dq, &data);
+                TEST_ASSERT_EQUAL(err, DEQUE_SUCCESS);
+                TEST_ASSERT_EQUAL_UINT8(i, data);
+        }
+}
+
+void test_pow2_fifo_wraparound_front(void) {
+        //arrange
+        struct deque dq;
+        int err;
+        unsigned char data = 0;
+        unsigned char buf[64];
+
+        //act
+        deque_new(&dq, buf, 64);
+
+        for (uint8_t i = 0; i < 40; i++) {
+                deque_push_front(&dq, (unsigned char) i);
+                deque_pop_back(&dq, &data);
+        }
+
+        for (uint8_t i = 0; i < 64; i++) {
+                deque_push_front(&dq, (unsigned char) i);
+        }
+
+        //assert
+        TEST_ASSERT_EQUAL(63, deque_peek_front(dq));
+        TEST_ASSERT_EQUAL(0, deque_peek_back(dq));
+
+        for (uint8_t i = 0; i < 64; i++) {
+                err = deque_pop_back(&dq, &data);
+                TEST_ASSERT_EQUAL(err, DEQUE_SUCCESS);
+                TEST_ASSERT_EQUAL_UINT8(i, data);
+        }
+}
+
+/******************************************************************************/
+
+void test_push_back_n_then_pop_front_n_across_wrap(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err_0;
+        uint8_t err_1;
+        unsigned char data = 0;
+        unsigned char src[7] = {1, 2, 3, 4, 5, 6, 7};
+        unsigned char dst[7] = {0};
+        unsigned char buf[10];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+
+        for (uint8_t i = 0; i < 6; i++) {
+                deque_push_back(&dq, 0);
+                deque_pop_front(&dq, &data);
+        }
+
+        err_0 = deque_push_back_n(&dq, src, sizeof(src));
+        err_1 = deque_pop_front_n(&dq, dst, sizeof(dst));
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err_0);
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err_1);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(src, dst, sizeof(src));
+        TEST_ASSERT_TRUE(deque_is_empty(dq));
+}
+
+void test_push_front_n_then_pop_back_n_across_wrap(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err_0;
+        uint8_t err_1;
+        unsigned char data = 0;
+        unsigned char src[7] = {1, 2, 3, 4, 5, 6, 7};
+        unsigned char dst[7] = {0};
+        unsigned char buf[10];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+
+        for (uint8_t i = 0; i < 5; i++) {
+                deque_push_back(&dq, 0);
+                deque_pop_front(&dq, &data);
+        }
+
+        err_0 = deque_push_front_n(&dq, src, sizeof(src));
+        err_1 = deque_pop_back_n(&dq, dst, sizeof(dst));
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err_0);
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err_1);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(src, dst, sizeof(src));
+        TEST_ASSERT_TRUE(deque_is_empty(dq));
+}
+
+void test_push_front_n_preserves_block_order(void) {
+        //arrange
+        struct deque dq;
+        unsigned char src[3] = {1, 2, 3};
+        unsigned char buf[4];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_push_back(&dq, 4);
+        deque_push_front_n(&dq, src, sizeof(src));
+
+        //assert
+        TEST_ASSERT_TRUE(deque_is_full(dq));
+        TEST_ASSERT_EQUAL(1, deque_peek_front(dq));
+        TEST_ASSERT_EQUAL(4, deque_peek_back(dq));
+}
+
+void test_bulk_interleaves_with_single_item_operations(void) {
+        //arrange
+        struct deque dq;
+        unsigned char data = 0;
+        unsigned char src[4] = {2, 3, 4, 5};
+        unsigned char dst[2] = {0};
+        unsigned char buf[255];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_push_back(&dq, 1);
+        deque_push_back_n(&dq, src, sizeof(src));
+        deque_push_back(&dq, 6);
+        deque_pop_back_n(&dq, dst, sizeof(dst));
+
+        //assert
+        TEST_ASSERT_EQUAL_UINT8(5, dst[0]);
+        TEST_ASSERT_EQUAL_UINT8(6, dst[1]);
+
+        for (uint8_t i = 1; i < 5; i++) {
+                deque_pop_front(&dq, &data);
+                TEST_ASSERT_EQUAL_UINT8(i, data);
+        }
+
+        TEST_ASSERT_TRUE(deque_is_empty(dq));
+}
+
+void test_push_back_n_on_insufficient_space_returns_error(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err_0;
+        uint8_t err_1;
+        unsigned char src[3] = {1, 2, 3};
+        unsigned char buf[4];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_push_back(&dq, 0);
+        deque_push_back(&dq, 0);
+        err_0 = deque_push_back_n(&dq, src, sizeof(src));
+        err_1 = deque_push_front_n(&dq, src, sizeof(src));
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_FULL, err_0);
+        TEST_ASSERT_EQUAL(DEQUE_FULL, err_1);
+        TEST_ASSERT_EQUAL_UINT8(2, dq.len);
+}
+
+void test_pop_front_n_on_insufficient_data_returns_error(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err_0;
+        uint8_t err_1;
+        unsigned char dst[3];
+        unsigned char buf[4];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_push_back(&dq, 0);
+        deque_push_back(&dq, 0);
+        err_0 = deque_pop_front_n(&dq, dst, sizeof(dst));
+        err_1 = deque_pop_back_n(&dq, dst, sizeof(dst));
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_EMPTY, err_0);
+        TEST_ASSERT_EQUAL(DEQUE_EMPTY, err_1);
+        TEST_ASSERT_EQUAL_UINT8(2, dq.len);
+}
+
+void test_bulk_null_input_returns_error(void) {
+#ifdef DEQUE_UNCHECKED
+        TEST_IGNORE_MESSAGE("null checks removed by DEQUE_UNCHECKED");
+#endif
+
+        //arrange
+        struct deque dq;
+        uint8_t err_0;
+        uint8_t err_1;
+        unsigned char buf[4];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        err_0 = deque_push_back_n(&dq, NULL, 1);
+        err_1 = deque_pop_front_n(&dq, NULL, 1);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_NULL_INPUT, err_0);
+        TEST_ASSERT_EQUAL(DEQUE_NULL_INPUT, err_1);
+}
+
+/******************************************************************************/
+
+void test_write_span_then_commit_is_visible_to_pop(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err_0;
+        uint8_t err_1;
+        span_len n;
+        unsigned char *span;
+        unsigned char data = 0;
+        unsigned char buf[8];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        err_0 = deque_write_span(&dq, &span, &n);
+        span[0] = 42;
+        span[1] = 52;
+        err_1 = deque_commit(&dq, 2);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err_0);
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err_1);
+        TEST_ASSERT_EQUAL_UINT8(8, n);
+        deque_pop_front(&dq, &data);
+        TEST_ASSERT_EQUAL_UINT8(42, data);
+        deque_pop_front(&dq, &data);
+        TEST_ASSERT_EQUAL_UINT8(52, data);
+}
+
+void test_write_span_stops_at_end_of_base_array(void) {
+        //arrange
+        struct deque dq;
+        span_len n_0;
+        span_len n_1;
+        unsigned char *span_0;
+        unsigned char *span_1;
+        unsigned char data = 0;
+        unsigned char buf[8];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+
+        for (uint8_t i = 0; i < 5; i++) {
+                deque_push_back(&dq, 0);
+                deque_pop_front(&dq, &data);
+        }
+
+        deque_write_span(&dq, &span_0, &n_0);
+        deque_commit(&dq, n_0);
+        deque_write_span(&dq, &span_1, &n_1);
+
+        //assert
+        TEST_ASSERT_EQUAL_PTR(buf + 5, span_0);
+        TEST_ASSERT_EQUAL_UINT8(3, n_0);
+        TEST_ASSERT_EQUAL_PTR(buf, span_1);
+        TEST_ASSERT_EQUAL_UINT8(5, n_1);
+}
+
+void test_read_span_then_release_across_wrap(void) {
+        //arrange
+        struct deque dq;
+        span_len n_0;
+        span_len n_1;
+        const unsigned char *span_0;
+        const unsigned char *span_1;
+        unsigned char data = 0;
+        unsigned char buf[8];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+
+        for (uint8_t i = 0; i < 6; i++) {
+                deque_push_back(&dq, 0);
+                deque_pop_front(&dq, &data);
+        }
+
+        for (uint8_t i = 0; i < 5; i++) {
+                deque_push_back(&dq, (unsigned char) i);
+        }
+
+        deque_read_span(&dq, &span_0, &n_0);
+        deque_release(&dq, n_0);
+        deque_read_span(&dq, &span_1, &n_1);
+        deque_release(&dq, n_1);
+
+        //assert
+        TEST_ASSERT_EQUAL_UINT8(2, n_0);
+        TEST_ASSERT_EQUAL_UINT8(0, span_0[0]);
+        TEST_ASSERT_EQUAL_UINT8(1, span_0[1]);
+        TEST_ASSERT_EQUAL_UINT8(3, n_1);
+        TEST_ASSERT_EQUAL_UINT8(2, span_1[0]);
+        TEST_ASSERT_EQUAL_UINT8(4, span_1[2]);
+        TEST_ASSERT_TRUE(deque_is_empty(dq));
+}
+
+void test_spans_on_full_and_empty_deque_return_error(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err_0;
+        uint8_t err_1;
+        span_len n_0;
+        span_len n_1;
+        unsigned char *span_0;
+        const unsigned char *span_1;
+        unsigned char buf[1];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        err_0 = deque_read_span(&dq, &span_1, &n_1);
+        deque_push_back(&dq, 42);
+        err_1 = deque_write_span(&dq, &span_0, &n_0);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_EMPTY, err_0);
+        TEST_ASSERT_EQUAL(DEQUE_FULL, err_1);
+        TEST_ASSERT_EQUAL_UINT8(0, n_0);
+        TEST_ASSERT_EQUAL_UINT8(0, n_1);
+}
+
+void test_commit_and_release_beyond_bounds_return_error(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err_0;
+        uint8_t err_1;
+        unsigned char buf[4];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_push_back(&dq, 42);
+        err_0 = deque_commit(&dq, 4);
+        err_1 = deque_release(&dq, 2);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_FULL, err_0);
+        TEST_ASSERT_EQUAL(DEQUE_EMPTY, err_1);
+        TEST_ASSERT_EQUAL_UINT8(1, dq.len);
+}
+
+/******************************************************************************/
+
+#ifndef TEST_DEQUE16
+
+void test_set_delim_counts_buffered_data(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err;
+        unsigned char src[5] = {'a', '\n', 'b', '\n', 'c'};
+        unsigned char buf[8];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_push_back_n(&dq, src, sizeof(src));
+        err = deque_set_delim(&dq, '\n');
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err);
+        TEST_ASSERT_EQUAL_UINT8(2, dq.ndelim);
+}
+
+void test_single_element_operations_track_delim(void) {
+        //arrange
+        struct deque dq;
+        unsigned char data = 0;
+        unsigned char buf[8];
+
+        //act-assert
+        deque_new(&dq, buf, sizeof(buf));
+        deque_set_delim(&dq, '\n');
+        TEST_ASSERT_FALSE(deque_has_delim(dq));
+
+        deque_push_back(&dq, 'a');
+        TEST_ASSERT_FALSE(deque_has_delim(dq));
+
+        deque_push_back(&dq, '\n');
+        deque_push_front(&dq, '\n');
+        TEST_ASSERT_EQUAL_UINT8(2, dq.ndelim);
+
+        deque_pop_front(&dq, &data);
+        TEST_ASSERT_EQUAL_UINT8(1, dq.ndelim);
+
+        deque_pop_back(&dq, &data);
+        TEST_ASSERT_FALSE(deque_has_delim(dq));
+}
+
+void test_block_operations_track_delim(void) {
+        //arrange
+        struct deque dq;
+        uint8_t n;
+        unsigned char *span;
+        unsigned char dst[4];
+        unsigned char src[4] = {'\n', 'a', '\n', 'b'};
+        unsigned char buf[8];
+
+        //act-assert
+        deque_new(&dq, buf, sizeof(buf));
+        deque_set_delim(&dq, '\n');
+
+        deque_push_back_n(&dq, src, sizeof(src));
+        deque_push_front_n(&dq, src, sizeof(src));
+        TEST_ASSERT_EQUAL_UINT8(4, dq.ndelim);
+
+        deque_pop_back_n(&dq, dst, 3);
+        TEST_ASSERT_EQUAL_UINT8(3, dq.ndelim);
+
+        deque_pop_front_n(&dq, dst, 2);
+        TEST_ASSERT_EQUAL_UINT8(2, dq.ndelim);
+
+        deque_release(&dq, 3);
+        TEST_ASSERT_FALSE(deque_has_delim(dq));
+
+        deque_write_span(&dq, &span, &n);
+        span[0] = '\n';
+        deque_commit(&dq, 1);
+        TEST_ASSERT_EQUAL_UINT8(1, dq.ndelim);
+}
+
+void test_find_delim_across_wrap(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err;
+        uint8_t offset;
+        unsigned char data = 0;
+        unsigned char src[6] = {'a', 'b', 'c', 'd', '\n', 'e'};
+        unsigned char buf[8];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_set_delim(&dq, '\n');
+
+        for (uint8_t i = 0; i < 6; i++) {
+                deque_push_back(&dq, 0);
+                deque_pop_front(&dq, &data);
+        }
+
+        deque_push_back_n(&dq, src, sizeof(src));
+        err = deque_find(&dq, &offset);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err);
+        TEST_ASSERT_EQUAL_UINT8(4, offset);
+}
+
+void test_find_delim_before_wrap(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err;
+        uint8_t offset;
+        unsigned char src[3] = {'a', '\n', 'b'};
+        unsigned char buf[8];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_set_delim(&dq, '\n');
+        deque_push_back_n(&dq, src, sizeof(src));
+        err = deque_find(&dq, &offset);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err);
+        TEST_ASSERT_EQUAL_UINT8(1, offset);
+}
+
+void test_find_without_delim_returns_error(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err_0;
+        uint8_t err_1;
+        uint8_t offset;
+        unsigned char buf[8];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_push_back(&dq, '\n');
+        err_0 = deque_find(&dq, &offset);
+        deque_set_delim(&dq, '\r');
+        err_1 = deque_find(&dq, &offset);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_NOT_FOUND, err_0);
+        TEST_ASSERT_EQUAL(DEQUE_NOT_FOUND, err_1);
+}
+
+void test_overwrite_push_back_evicts_front(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err;
+        unsigned char data = 0;
+        unsigned char buf[4];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_set_overwrite(&dq, 1);
+
+        for (uint8_t i = 0; i < 10; i++) {
+                err = deque_push_back(&dq, i);
+                TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err);
+        }
+
+        //assert
+        TEST_ASSERT_EQUAL_UINT16(6, dq.overwrites);
+
+        for (uint8_t i = 6; i < 10; i++) {
+                deque_pop_front(&dq, &data);
+                TEST_ASSERT_EQUAL_UINT8(i, data);
+        }
+}
+
+void test_overwrite_push_front_evicts_back(void) {
+        //arrange
+        struct deque dq;
+        unsigned char data = 0;
+        unsigned char buf[3];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_set_overwrite(&dq, 1);
+
+        for (uint8_t i = 0; i < 5; i++) {
+                deque_push_front(&dq, i);
+        }
+
+        //assert
+        TEST_ASSERT_EQUAL_UINT16(2, dq.overwrites);
+
+        for (uint8_t i = 2; i < 5; i++) {
+                deque_pop_back(&dq, &data);
+                TEST_ASSERT_EQUAL_UINT8(i, data);
+        }
+}
+
+void test_overwrite_push_back_n_keeps_newest(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err_0;
+        uint8_t err_1;
+        unsigned char src[6] = {1, 2, 3, 4, 5, 6};
+        unsigned char dst[4];
+        unsigned char expect_0[4] = {0, 1, 2, 3};
+        unsigned char expect_1[4] = {3, 4, 5, 6};
+        unsigned char buf[4];
+
+        //act-assert
+        deque_new(&dq, buf, sizeof(buf));
+        deque_set_overwrite(&dq, 1);
+
+        deque_push_back(&dq, 9);
+        deque_push_back(&dq, 0);
+        err_0 = deque_push_back_n(&dq, src, 3);
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err_0);
+        TEST_ASSERT_EQUAL_UINT16(1, dq.overwrites);
+        deque_pop_front_n(&dq, dst, 4);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expect_0, dst, 4);
+
+        deque_push_back(&dq, 0);
+        err_1 = deque_push_back_n(&dq, src, sizeof(src));
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err_1);
+        TEST_ASSERT_EQUAL_UINT16(4, dq.overwrites);
+        deque_pop_front_n(&dq, dst, 4);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expect_1, dst, 4);
+}
+
+void test_overwrite_push_front_n_keeps_newest(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err;
+        unsigned char src[6] = {1, 2, 3, 4, 5, 6};
+        unsigned char dst[4];
+        unsigned char expect[4] = {1, 2, 3, 4};
+        unsigned char buf[4];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_set_overwrite(&dq, 1);
+        deque_push_back(&dq, 0);
+        err = deque_push_front_n(&dq, src, sizeof(src));
+        deque_pop_front_n(&dq, dst, 4);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err);
+        TEST_ASSERT_EQUAL_UINT16(3, dq.overwrites);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expect, dst, 4);
+}
+
+void test_overwrite_evictions_track_delim(void) {
+        //arrange
+        struct deque dq;
+        unsigned char buf[2];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_set_delim(&dq, '\n');
+        deque_set_overwrite(&dq, 1);
+        deque_push_back(&dq, '\n');
+        deque_push_back(&dq, 'a');
+        deque_push_back(&dq, 'b');
+
+        //assert
+        TEST_ASSERT_FALSE(deque_has_delim(dq));
+}
+
+void test_overwrite_disabled_restores_full_error(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err;
+        unsigned char buf[1];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_set_overwrite(&dq, 1);
+        deque_push_back(&dq, 1);
+        deque_push_back(&dq, 2);
+        deque_set_overwrite(&dq, 0);
+        err = deque_push_back(&dq, 3);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_FULL, err);
+        TEST_ASSERT_EQUAL_UINT16(0, dq.overwrites);
+        TEST_ASSERT_EQUAL(2, deque_peek_front(dq));
+}
+
+void test_at_reads_in_place_across_wrap(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err;
+        unsigned char data = 0;
+        unsigned char src[5] = {1, 2, 3, 4, 5};
+        unsigned char dst[4];
+        unsigned char buf[6];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_push_back_n(&dq, src, 4);
+        deque_pop_front_n(&dq, dst, 4);
+        deque_push_back_n(&dq, src, sizeof(src));
+
+        //assert
+        for (uint8_t i = 0; i < 5; i++) {
+                err = deque_at(&dq, i, &data);
+                TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err);
+                TEST_ASSERT_EQUAL_UINT8(i + 1, data);
+        }
+
+        TEST_ASSERT_EQUAL_UINT8(5, dq.len);
+}
+
+void test_at_beyond_len_returns_error(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err_0;
+        uint8_t err_1;
+        unsigned char data = 0;
+        unsigned char buf[4];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        err_0 = deque_at(&dq, 0, &data);
+        deque_push_back(&dq, 42);
+        err_1 = deque_at(&dq, 1, &data);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_INDEX_BOUNDS, err_0);
+        TEST_ASSERT_EQUAL(DEQUE_INDEX_BOUNDS, err_1);
+}
+
+void test_iter_walks_front_to_back_across_wrap(void) {
+        //arrange
+        struct deque dq;
+        struct deque_iter it;
+        unsigned char data = 0;
+        uint8_t count = 0;
+        unsigned char buf[5];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+
+        for (uint8_t i = 2; i < 5; i++) {
+                deque_push_back(&dq, i);
+        }
+
+        for (uint8_t i = 2; i > 0; i--) {
+                deque_push_front(&dq, (unsigned char) (i - 1));
+        }
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_FULL, deque_push_back(&dq, 0));
+
+        deque_foreach(it, dq, data) {
+                TEST_ASSERT_EQUAL_UINT8(count, data);
+                count++;
+        }
+
+        TEST_ASSERT_EQUAL_UINT8(5, count);
+        TEST_ASSERT_EQUAL_UINT8(5, dq.len);
+        TEST_ASSERT_EQUAL(DEQUE_EMPTY, deque_iter_next(&it, &data));
+}
+
+void test_iter_on_empty_deque_visits_nothing(void) {
+        //arrange
+        struct deque dq;
+        struct deque_iter it;
+        uint8_t err;
+        unsigned char data = 0;
+        unsigned char buf[4];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_iter_new(&it, &dq);
+        err = deque_iter_next(&it, &data);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_EMPTY, err);
+}
+
+void test_at_and_iter_null_input_returns_error(void) {
+#ifdef DEQUE_UNCHECKED
+        TEST_IGNORE_MESSAGE("null checks removed by DEQUE_UNCHECKED");
+#endif
+
+        //arrange
+        struct deque dq;
+        struct deque_iter it;
+        unsigned char buf[4];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_push_back(&dq, 42);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_NULL_INPUT, deque_at(&dq, 0, NULL));
+        TEST_ASSERT_EQUAL(DEQUE_NULL_INPUT, deque_iter_new(&it, NULL));
+        TEST_ASSERT_EQUAL(DEQUE_NULL_INPUT, deque_iter_new(NULL, &dq));
+}
+
+void test_linearize_wrapped_data_starts_at_index_zero(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err;
+        unsigned char data = 0;
+        unsigned char src[7] = {1, 2, 3, 4, 5, 6, 7};
+        unsigned char dst[5];
+        unsigned char buf[7];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_push_back_n(&dq, src, 5);
+        deque_pop_front_n(&dq, dst, 5);
+        deque_push_back_n(&dq, src, sizeof(src));
+        err = deque_linearize(&dq);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err);
+        TEST_ASSERT_EQUAL_UINT8(0, dq.front);
+        TEST_ASSERT_EQUAL_UINT8(0, dq.back);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(src, dq.buf, sizeof(src));
+
+        deque_pop_back(&dq, &data);
+        TEST_ASSERT_EQUAL_UINT8(7, data);
+}
+
+void test_linearize_partial_wrap_keeps_deque_usable(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err;
+        unsigned char src[4] = {'a', 'b', 'c', 'd'};
+        unsigned char dst[6] = {0};
+        unsigned char expect[5] = {'a', 'b', 'c', 'd', 'e'};
+        unsigned char buf[8];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_push_back_n(&dq, dst, 6);
+        deque_pop_front_n(&dq, dst, 6);
+        deque_push_back_n(&dq, src, sizeof(src));
+        err = deque_linearize(&dq);
+        deque_push_back(&dq, 'e');
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expect, dq.buf, 5);
+        TEST_ASSERT_EQUAL_UINT8(5, dq.len);
+
+        deque_pop_front_n(&dq, dst, 5);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expect, dst, 5);
+}
+
+void test_linearize_unwrapped_data_slides_down(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err;
+        unsigned char src[3] = {7, 8, 9};
+        unsigned char dst[2] = {0};
+        unsigned char buf[6];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_push_back_n(&dq, dst, 2);
+        deque_pop_front_n(&dq, dst, 2);
+        deque_push_back_n(&dq, src, sizeof(src));
+        err = deque_linearize(&dq);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err);
+        TEST_ASSERT_EQUAL_UINT8(0, dq.front);
+        TEST_ASSERT_EQUAL_UINT8(3, dq.back);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(src, dq.buf, sizeof(src));
+}
+
+#endif /* TEST_DEQUE16 */
+
+/*******************************************************************************
+* statistics tests, compiled into the test_deque_stats build only
+*/
+
+#ifdef DEQUE_STATS
+
+void test_stats_track_high_water_mark(void) {
+        //arrange
+        struct deque dq;
+        struct deque_stats stats;
+        unsigned char data = 0;
+        unsigned char src[3] = {1, 2, 3};
+        unsigned char dst[4];
+        unsigned char buf[8];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_push_back(&dq, 0);
+        deque_push_front_n(&dq, src, sizeof(src));
+        deque_commit(&dq, 2);
+        deque_pop_front_n(&dq, dst, 4);
+        deque_push_back(&dq, 0);
+        deque_pop_back(&dq, &data);
+        deque_stats_read(&dq, &stats, 0);
+
+        //assert
+        TEST_ASSERT_EQUAL_UINT8(6, stats.hwm);
+        TEST_ASSERT_EQUAL_UINT16(0, stats.full);
+        TEST_ASSERT_EQUAL_UINT16(0, stats.empty);
+#ifdef DEQUE_STATS_TOTAL
+        TEST_ASSERT_EQUAL_UINT32(7, stats.total);
+#endif
+}
+
+void test_stats_count_rejected_operations(void) {
+        //arrange
+        struct deque dq;
+        struct deque_stats stats;
+        unsigned char data = 0;
+        unsigned char src[3] = {1, 2, 3};
+        unsigned char buf[2];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_pop_back(&dq, &data);
+        deque_pop_front(&dq, &data);
+        deque_pop_back_n(&dq, src, 1);
+        deque_release(&dq, 1);
+        deque_push_back_n(&dq, src, sizeof(src));
+        deque_push_back(&dq, 1);
+        deque_push_front(&dq, 2);
+        deque_push_back(&dq, 3);
+        deque_commit(&dq, 1);
+        deque_stats_read(&dq, &stats, 0);
+
+        //assert
+        TEST_ASSERT_EQUAL_UINT8(2, stats.hwm);
+        TEST_ASSERT_EQUAL_UINT16(3, stats.full);
+        TEST_ASSERT_EQUAL_UINT16(4, stats.empty);
+#ifdef DEQUE_STATS_TOTAL
+        TEST_ASSERT_EQUAL_UINT32(2, stats.total);
+#endif
+}
+
+void test_stats_reset_restarts_from_current_len(void) {
+        //arrange
+        struct deque dq;
+        struct deque_stats stats;
+        unsigned char data = 0;
+        unsigned char buf[4];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+
+        for (uint8_t i = 0; i < 5; i++) {
+                deque_push_back(&dq, i);
+        }
+
+        deque_pop_front(&dq, &data);
+        deque_pop_front(&dq, &data);
+        deque_stats_read(&dq, &stats, 1);
+        deque_stats_read(&dq, &stats, 0);
+
+        //assert
+        TEST_ASSERT_EQUAL_UINT8(2, stats.hwm);
+        TEST_ASSERT_EQUAL_UINT16(0, stats.full);
+        TEST_ASSERT_EQUAL_UINT16(0, stats.empty);
+#ifdef DEQUE_STATS_TOTAL
+        TEST_ASSERT_EQUAL_UINT32(0, stats.total);
+#endif
+}
+
+void test_stats_null_input_returns_error(void) {
+#ifdef DEQUE_UNCHECKED
+        TEST_IGNORE_MESSAGE("null checks removed by DEQUE_UNCHECKED");
+#endif
+
+        //arrange
+        struct deque dq;
+        struct deque_stats stats;
+        unsigned char buf[4];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_NULL_INPUT, deque_stats_read(&dq, NULL, 0));
+        TEST_ASSERT_EQUAL(DEQUE_NULL_INPUT, deque_stats_read(NULL, &stats, 0));
+}
+
+#endif /* DEQUE_STATS */
+
+/*******************************************************************************
+* watermark tests, compiled into the test_deque_watermark build only
+*/
+
+#ifdef DEQUE_WATERMARK
+
+static uint8_t low_calls;
+static uint8_t high_calls;
+
+static void on_low(struct deque *dq) {
+        (void) dq;
+        low_calls++;
+}
+
+static void on_high(struct deque *dq) {
+        (void) dq;
+        high_calls++;
+}
+
+void test_watermark_hooks_alternate_with_hysteresis(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err;
+        unsigned char data = 0;
+        unsigned char buf[8];
+
+        low_calls = 0;
+        high_calls = 0;
+
+        //act-assert
+        deque_new(&dq, buf, sizeof(buf));
+        err = deque_set_watermark(&dq, 2, 6, on_low, on_high);
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err);
+
+        for (uint8_t i = 0; i < 5; i++) {
+                deque_push_back(&dq, i);
+        }
+
+        TEST_ASSERT_EQUAL_UINT8(0, high_calls);
+
+        deque_push_back(&dq, 5);
+        deque_push_back(&dq, 6);
+        deque_pop_front(&dq, &data);
+        deque_push_back(&dq, 7);
+        TEST_ASSERT_EQUAL_UINT8(1, high_calls);
+        TEST_ASSERT_EQUAL_UINT8(0, low_calls);
+
+        for (uint8_t i = 0; i < 4; i++) {
+                deque_pop_front(&dq, &data);
+        }
+
+        TEST_ASSERT_EQUAL_UINT8(0, low_calls);
+
+        deque_pop_front(&dq, &data);
+        deque_pop_front(&dq, &data);
+        deque_push_back(&dq, 8);
+        deque_pop_front(&dq, &data);
+        TEST_ASSERT_EQUAL_UINT8(1, low_calls);
+        TEST_ASSERT_EQUAL_UINT8(1, high_calls);
+}
+
+void test_watermark_bulk_operations_fire_once(void) {
+        //arrange
+        struct deque dq;
+        unsigned char src[8] = {0};
+        unsigned char buf[8];
+
+        low_calls = 0;
+        high_calls = 0;
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_set_watermark(&dq, 1, 4, on_low, on_high);
+        deque_push_back_n(&dq, src, 8);
+        deque_release(&dq, 8);
+        deque_commit(&dq, 5);
+        deque_pop_back_n(&dq, src, 5);
+
+        //assert
+        TEST_ASSERT_EQUAL_UINT8(2, high_calls);
+        TEST_ASSERT_EQUAL_UINT8(2, low_calls);
+}
+
+void test_watermark_set_above_high_fires_immediately(void) {
+        //arrange
+        struct deque dq;
+        unsigned char src[4] = {0};
+        unsigned char buf[8];
+
+        low_calls = 0;
+        high_calls = 0;
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        deque_push_back_n(&dq, src, sizeof(src));
+        deque_set_watermark(&dq, 0, 3, NULL, on_high);
+
+        //assert
+        TEST_ASSERT_EQUAL_UINT8(1, high_calls);
+        TEST_ASSERT_TRUE(dq.flags & DEQUE_ABOVE_HIGH);
+}
+
+void test_watermark_illegal_thresholds_return_error(void) {
+        //arrange
+        struct deque dq;
+        uint8_t err_0;
+        uint8_t err_1;
+        uint8_t err_2;
+        unsigned char buf[8];
+
+        //act
+        deque_new(&dq, buf, sizeof(buf));
+        err_0 = deque_set_watermark(&dq, 4, 4, on_low, on_high);
+        err_1 = deque_set_watermark(&dq, 0, 9, on_low, on_high);
+        err_2 = deque_set_watermark(&dq, 0, 0, NULL, NULL);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_CAP_BOUNDS, err_0);
+        TEST_ASSERT_EQUAL(DEQUE_CAP_BOUNDS, err_1);
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err_2);
+}
+
+#endif /* DEQUE_WATERMARK */
+
+/******************************************************************************/
+
+#ifdef TEST_DEQUE16
+
+void test_deque16_large_capacity_fifo_wraparound(void) {
+        //arrange
+        struct deque16 dq;
+        int err;
+        unsigned char data = 0;
+        unsigned char buf[1500];
+
+        //act
+        deque16_new(&dq, buf, sizeof(buf));
+
+        for (uint16_t i = 0; i < 1000; i++) {
+                deque16_push_back(&dq, 0);
+                deque16_pop_front(&dq, &data);
+        }
+
+        for (uint16_t i = 0; i < 1500; i++) {
+                deque16_push_back(&dq, (unsigned char) i);
+        }
+
+        //assert
+        TEST_ASSERT_TRUE(deque16_is_full(dq));
+
+        for (uint16_t i = 0; i < 1500; i++) {
+                err = deque16_pop_front(&dq, &data);
+                TEST_ASSERT_EQUAL(err, DEQUE_SUCCESS);
+                TEST_ASSERT_EQUAL_UINT8((unsigned char) i, data);
+        }
+}
+
+void test_deque16_large_block_across_wrap(void) {
+        //arrange
+        struct deque16 dq;
+        uint8_t err_0;
+        uint8_t err_1;
+        unsigned char data = 0;
+        static unsigned char src[1200];
+        static unsigned char dst[1200];
+        unsigned char buf[1500];
+
+        for (uint16_t i = 0; i < sizeof(src); i++) {
+                src[i] = (unsigned char) (i * 7);
+        }
+
+        //act
+        deque16_new(&dq, buf, sizeof(buf));
+
+        for (uint16_t i = 0; i < 900; i++) {
+                deque16_push_front(&dq, 0);
+                deque16_pop_back(&dq, &data);
+        }
+
+        err_0 = deque16_push_back_n(&dq, src, sizeof(src));
+        err_1 = deque16_pop_front_n(&dq, dst, sizeof(dst));
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err_0);
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err_1);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(src, dst, sizeof(src));
+        TEST_ASSERT_TRUE(deque16_is_empty(dq));
+}
+
+void test_deque16_power_of_two_capacity_sets_mask(void) {
+        //arrange
+        struct deque16 dq;
+        unsigned char buf[1024];
+
+        //act
+        deque16_new(&dq, buf, sizeof(buf));
+
+        //assert
+        TEST_ASSERT_EQUAL_UINT16(1023, dq.mask);
+}
+
+#endif /* TEST_DEQUE16 */
+
+int main(void)
+{
+        UNITY_BEGIN();
+
+        //initialization tests
+        RUN_TEST(test_new_deque_zero_capacity_returns_error);
+        RUN_TEST(test_new_deque_null_buffer_returns_error);
+        RUN_TEST(test_new_deque_with_legal_parameters_returns_success);
+
+        //single-item max-element buffer
+        RUN_TEST(test_max_push_back_then_pop_back_returns_correct_data);
+        RUN_TEST(test_max_push_front_then_pop_front_returns_correct_data);
+        RUN_TEST(test_max_push_back_then_pop_front_returns_correct_data);
+        RUN_TEST(test_max_push_front_then_pop_back_returns_correct_data);
+
+        //single-item single-element buffer
+        RUN_TEST(test_singleton_push_back_then_pop_back_returns_correct_data);
+        RUN_TEST(test_singleton_push_front_then_pop_front_returns_correct_data);
+        RUN_TEST(test_singleton_push_back_then_pop_front_returns_correct_data);
+        RUN_TEST(test_singleton_push_front_then_pop_back_returns_correct_data);
+
+        //single-item mid-size-element buffer
+        RUN_TEST(test_mid_push_back_then_pop_back_returns_correct_data);
+        RUN_TEST(test_mid_push_front_then_pop_front_returns_correct_data);
+        RUN_TEST(test_mid_push_back_then_pop_front_returns_correct_data);
+        RUN_TEST(test_mid_push_front_then_pop_back_returns_correct_data);
+
+        //single-item error conditions
+        RUN_TEST(test_push_back_on_full_array_returns_error);
+        RUN_TEST(test_push_front_on_full_array_returns_error);
+        RUN_TEST(test_pop_back_on_empty_array_returns_error);
+        RUN_TEST(test_pop_front_on_empty_array_returns_error);
+
+        //check empty
+        RUN_TEST(test_deque_made_empty_is_truly_empty_via_pop_back);
+        RUN_TEST(test_deque_made_empty_is_truly_empty_via_pop_front);
+
+        //helper macros
+        RUN_TEST(test_macro_deque_is_full);
+        RUN_TEST(test_macro_deque_is_not_full);
+        RUN_TEST(test_macro_deque_is_empty);
+        RUN_TEST(test_macro_deque_is_not_empty);
+        RUN_TEST(test_macro_deque_peek_back);
+        RUN_TEST(test_macro_deque_peek_front);
+
+        //lifo tests from stack side
+        RUN_TEST(test_max_lifo_push_then_pop_iteration_back);
+        RUN_TEST(test_mid_lifo_push_then_pop_iteration_back);
+        RUN_TEST(test_singleton_lifo_push_then_pop_iteration_back);
+        RUN_TEST(test_lifo_fill_completely_then_purge_back);
+        RUN_TEST(test_lifo_fill_completely_then_purge_and_repeat_back);
+
+        //lifo tests from queue side
+        RUN_TEST(test_max_lifo_push_then_pop_iteration_front);
+        RUN_TEST(test_mid_lifo_push_then_pop_iteration_front);
+        RUN_TEST(test_singleton_lifo_push_then_pop_iteration_front);
+        RUN_TEST(test_lifo_fill_completely_then_purge_front);
+        RUN_TEST(test_lifo_fill_completely_then_purge_and_repeat_front);
+
+        //fifo mix tests
+        RUN_TEST(test_mixed_max_push_back_pop_front_iteration);
+        RUN_TEST(test_mixed_mid_push_back_pop_front_iteration);
+        RUN_TEST(test_mixed_singleton_push_back_pop_front_iteration);
+        RUN_TEST(test_mixed_max_push_front_pop_back_iteration);
+        RUN_TEST(test_mixed_mid_push_front_pop_back_iteration);
+        RUN_TEST(test_mixed_singleton_push_front_pop_back_iteration);
+        RUN_TEST(test_fifo_fill_completely_then_purge_back);
+        RUN_TEST(test_fifo_fill_completely_then_purge_and_repeat_back);
+        RUN_TEST(test_fifo_fill_completely_then_purge_front);
+        RUN_TEST(test_fifo_fill_completely_then_purge_and_repeat_front);
+
+        //power of two capacity
+        RUN_TEST(test_new_deque_power_of_two_capacity_sets_mask);
+        RUN_TEST(test_new_deque_other_capacity_clears_mask);
+        RUN_TEST(test_pow2_fifo_wraparound_back);
+        RUN_TEST(test_pow2_fifo_wraparound_front);
+
+        //bulk operations
+        RUN_TEST(test_push_back_n_then_pop_front_n_across_wrap);
+        RUN_TEST(test_push_front_n_then_pop_back_n_across_wrap);
+        RUN_TEST(test_push_front_n_preserves_block_order);
+        RUN_TEST(test_bulk_interleaves_with_single_item_operations);
+        RUN_TEST(test_push_back_n_on_insufficient_space_returns_error);
+        RUN_TEST(test_pop_front_n_on_insufficient_data_returns_error);
+        RUN_TEST(test_bulk_null_input_returns_error);
+
+        //span operations
+        RUN_TEST(test_write_span_then_commit_is_visible_to_pop);
+        RUN_TEST(test_write_span_stops_at_end_of_base_array);
+        RUN_TEST(test_read_span_then_release_across_wrap);
+        RUN_TEST(test_spans_on_full_and_empty_deque_return_error);
+        RUN_TEST(test_commit_and_release_beyond_bounds_return_error);
+
+#ifndef TEST_DEQUE16
+        //delimiter tracking
+        RUN_TEST(test_set_delim_counts_buffered_data);
+        RUN_TEST(test_single_element_operations_track_delim);
+        RUN_TEST(test_block_operations_track_delim);
+        RUN_TEST(test_find_delim_across_wrap);
+        RUN_TEST(test_find_delim_before_wrap);
+        RUN_TEST(test_find_without_delim_returns_error);
+
+        //overwrite mode
+        RUN_TEST(test_overwrite_push_back_evicts_front);
+        RUN_TEST(test_overwrite_push_front_evicts_back);
+        RUN_TEST(test_overwrite_push_back_n_keeps_newest);
+        RUN_TEST(test_overwrite_push_front_n_keeps_newest);
+        RUN_TEST(test_overwrite_evictions_track_delim);
+        RUN_TEST(test_overwrite_disabled_restores_full_error);
+
+        //random access and iteration
+        RUN_TEST(test_at_reads_in_place_across_wrap);
+        RUN_TEST(test_at_beyond_len_returns_error);
+        RUN_TEST(test_iter_walks_front_to_back_across_wrap);
+        RUN_TEST(test_iter_on_empty_deque_visits_nothing);
+        RUN_TEST(test_at_and_iter_null_input_returns_error);
+
+        //linearize
+        RUN_TEST(test_linearize_wrapped_data_starts_at_index_zero);
+        RUN_TEST(test_linearize_partial_wrap_keeps_deque_usable);
+        RUN_TEST(test_linearize_unwrapped_data_slides_down);
+#endif
+
+#ifdef DEQUE_STATS
+        //statistics
+        RUN_TEST(test_stats_track_high_water_mark);
+        RUN_TEST(test_stats_count_rejected_operations);
+        RUN_TEST(test_stats_reset_restarts_from_current_len);
+        RUN_TEST(test_stats_null_input_returns_error);
+#endif
+
+#ifdef DEQUE_WATERMARK
+        //watermarks
+        RUN_TEST(test_watermark_hooks_alternate_with_hysteresis);
+        RUN_TEST(test_watermark_bulk_operations_fire_once);
+        RUN_TEST(test_watermark_set_above_high_fires_immediately);
+        RUN_TEST(test_watermark_illegal_thresholds_return_error);
+#endif
+
+#ifdef TEST_DEQUE16
+        //16-bit capacities
+        RUN_TEST(test_deque16_large_capacity_fifo_wraparound);
+        RUN_TEST(test_deque16_large_block_across_wrap);
+        RUN_TEST(test_deque16_power_of_two_capacity_sets_mask);
+#endif
 
         return UNITY_END();
 }
@@ -0,0 +1,178 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Unit tests for typed double ended queue generator
+*/
+
+#include <stdint.h>
+
+#include "deque_define.h"
+#include "unity.h"
+
+struct sample {
+        uint8_t channel;
+        uint16_t value;
+};
+
+DEQUE_DEFINE(adc_fifo, uint16_t, 32);
+DEQUE_DEFINE(sample_fifo, struct sample, 5);
+DEQUE_DEFINE(single_fifo, uint16_t, 1);
+
+void test_new_typed_deque_null_buffer_returns_error(void) {
+        //arrange
+        struct adc_fifo dq;
+        uint8_t err;
+
+        //act
+        err = adc_fifo_new(&dq, NULL);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_NULL_INPUT, err);
+}
+
+void test_new_typed_deque_with_legal_parameters_returns_success(void) {
+        //arrange
+        struct adc_fifo dq;
+        uint8_t err;
+        uint16_t buf[32];
+
+        //act
+        err = adc_fifo_new(&dq, buf);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_SUCCESS, err);
+        TEST_ASSERT_TRUE(adc_fifo_is_empty(&dq));
+}
+
+void test_typed_push_back_on_full_array_returns_error(void) {
+        //arrange
+        struct single_fifo dq;
+        uint8_t err;
+        uint16_t buf[1];
+
+        //act
+        single_fifo_new(&dq, buf);
+        single_fifo_push_back(&dq, 1000);
+        err = single_fifo_push_front(&dq, 2000);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_FULL, err);
+        TEST_ASSERT_TRUE(single_fifo_is_full(&dq));
+}
+
+void test_typed_pop_on_empty_array_returns_error(void) {
+        //arrange
+        struct single_fifo dq;
+        uint8_t err_0;
+        uint8_t err_1;
+        uint16_t data;
+        uint16_t buf[1];
+
+        //act
+        single_fifo_new(&dq, buf);
+        err_0 = single_fifo_pop_back(&dq, &data);
+        err_1 = single_fifo_pop_front(&dq, &data);
+
+        //assert
+        TEST_ASSERT_EQUAL(DEQUE_EMPTY, err_0);
+        TEST_ASSERT_EQUAL(DEQUE_EMPTY, err_1);
+}
+
+void test_typed_peek_returns_ends(void) {
+        //arrange
+        struct adc_fifo dq;
+        uint16_t front;
+        uint16_t back;
+        uint16_t buf[32];
+
+        //act
+        adc_fifo_new(&dq, buf);
+        adc_fifo_push_front(&dq, 1023);
+        adc_fifo_push_back(&dq, 512);
+
+        adc_fifo_peek_front(&dq, &front);
+        adc_fifo_peek_back(&dq, &back);
+
+        //assert
+        TEST_ASSERT_EQUAL_UINT16(1023, front);
+        TEST_ASSERT_EQUAL_UINT16(512, back);
+}
+
+void test_typed_pow2_fifo_wraparound(void) {
+        //arrange
+        struct adc_fifo dq;
+        int err;
+        uint16_t data;
+        uint16_t buf[32];
+
+        //act
+        adc_fifo_new(&dq, buf);
+
+        for (uint16_t i = 0; i < 20; i++) {
+                adc_fifo_push_back(&dq, i);
+                adc_fifo_pop_front(&dq, &data);
+        }
+
+        for (uint16_t i = 0; i < 32; i++) {
+                adc_fifo_push_back(&dq, (uint16_t) (i * 1000));
+        }
+
+        //assert
+        for (uint16_t i = 0; i < 32; i++) {
+                err = adc_fifo_pop_front(&dq, &data);
+                TEST_ASSERT_EQUAL(err, DEQUE_SUCCESS);
+                TEST_ASSERT_EQUAL_UINT16(i * 1000, data);
+        }
+}
+
+void test_typed_struct_lifo_wraparound_front(void) {
+        //arrange
+        struct sample_fifo dq;
+        int err;
+        struct sample data;
+        struct sample buf[5];
+
+        //act
+        sample_fifo_new(&dq, buf);
+
+        for (uint8_t i = 0; i < 3; i++) {
+                data.channel = i;
+                data.value = 0;
+                sample_fifo_push_front(&dq, data);
+                sample_fifo_pop_back(&dq, &data);
+        }
+
+        for (uint8_t i = 0; i < 5; i++) {
+                data.channel = i;
+                data.value = (uint16_t) (i + 100);
+                sample_fifo_push_front(&dq, data);
+        }
+
+        //assert
+        for (uint8_t i = 5; i != 0; i--) {
+                err = sample_fifo_pop_front(&dq, &data);
+                TEST_ASSERT_EQUAL(err, DEQUE_SUCCESS);
+                TEST_ASSERT_EQUAL_UINT8(i - 1, data.channel);
+                TEST_ASSERT_EQUAL_UINT16(i + 99, data.value);
+        }
+}
+
+int main(void)
+{
+        UNITY_BEGIN();
+
+        //initialization tests
+        RUN_TEST(test_new_typed_deque_null_buffer_returns_error);
+        RUN_TEST(test_new_typed_deque_with_legal_parameters_returns_success);
+
+        //error conditions
+        RUN_TEST(test_typed_push_back_on_full_array_returns_error);
+        RUN_TEST(test_typed_pop_on_empty_array_returns_error);
+
+        //element types and wraparound
+        RUN_TEST(test_typed_peek_returns_ends);
+        RUN_TEST(test_typed_pow2_fifo_wraparound);
+        RUN_TEST(test_typed_struct_lifo_wraparound_front);
+
+        return UNITY_END();
+}
@@ -0,0 +1,211 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Unit tests for variable length record queue
+*/
+
+#include <stdint.h>
+
+#include "msgq.h"
+#include "unity.h"
+
+void test_new_msgq_capacity_below_two_returns_error(void) {
+        //arrange
+        struct msgq q;
+        uint8_t err;
+        unsigned char buf[1];
+
+        //act
+        err = msgq_new(&q, buf, sizeof(buf));
+
+        //assert
+        TEST_ASSERT_EQUAL(MSGQ_CAP_BOUNDS, err);
+}
+
+void test_new_msgq_null_buffer_returns_error(void) {
+        //arrange
+        struct msgq q;
+        uint8_t err;
+
+        //act
+        err = msgq_new(&q, NULL, 8);
+
+        //assert
+        TEST_ASSERT_EQUAL(MSGQ_NULL_INPUT, err);
+}
+
+void test_new_msgq_with_legal_parameters_returns_success(void) {
+        //arrange
+        struct msgq q;
+        uint8_t err;
+        unsigned char buf[8];
+
+        //act
+        err = msgq_new(&q, buf, sizeof(buf));
+
+        //assert
+        TEST_ASSERT_EQUAL(MSGQ_SUCCESS, err);
+        TEST_ASSERT_TRUE(msgq_is_empty(q));
+}
+
+void test_msgq_records_keep_boundaries_and_order(void) {
+        //arrange
+        struct msgq q;
+        uint8_t err;
+        uint8_t n;
+        unsigned char dst[8];
+        unsigned char buf[16];
+
+        //act
+        msgq_new(&q, buf, sizeof(buf));
+        msgq_push_record(&q, (const unsigned char *) "hello\n", 6);
+        msgq_push_record(&q, (const unsigned char *) "a", 1);
+        msgq_push_record(&q, (const unsigned char *) "xyz", 3);
+
+        //assert
+        TEST_ASSERT_EQUAL_UINT8(3, msgq_count(q));
+
+        err = msgq_pop_record(&q, dst, sizeof(dst), &n);
+        TEST_ASSERT_EQUAL(MSGQ_SUCCESS, err);
+        TEST_ASSERT_EQUAL_UINT8(6, n);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY("hello\n", dst, 6);
+
+        err = msgq_pop_record(&q, dst, sizeof(dst), &n);
+        TEST_ASSERT_EQUAL(MSGQ_SUCCESS, err);
+        TEST_ASSERT_EQUAL_UINT8(1, n);
+        TEST_ASSERT_EQUAL_UINT8('a', dst[0]);
+
+        err = msgq_pop_record(&q, dst, sizeof(dst), &n);
+        TEST_ASSERT_EQUAL(MSGQ_SUCCESS, err);
+        TEST_ASSERT_EQUAL_UINT8(3, n);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY("xyz", dst, 3);
+
+        TEST_ASSERT_TRUE(msgq_is_empty(q));
+}
+
+void test_msgq_push_without_room_for_whole_record_returns_error(void) {
+        //arrange
+        struct msgq q;
+        uint8_t err;
+        unsigned char src[4] = {1, 2, 3, 4};
+        unsigned char buf[8];
+
+        //act
+        msgq_new(&q, buf, sizeof(buf));
+        msgq_push_record(&q, src, 3);
+        err = msgq_push_record(&q, src, 4);
+
+        //assert
+        TEST_ASSERT_EQUAL(MSGQ_FULL, err);
+        TEST_ASSERT_EQUAL_UINT8(1, msgq_count(q));
+        TEST_ASSERT_EQUAL_UINT8(4, q.dq.len);
+}
+
+void test_msgq_push_record_length_out_of_bounds_returns_error(void) {
+        //arrange
+        struct msgq q;
+        uint8_t err_0;
+        uint8_t err_1;
+        uint8_t err_2;
+        unsigned char src[8] = {0};
+        unsigned char buf[8];
+
+        //act
+        msgq_new(&q, buf, sizeof(buf));
+        err_0 = msgq_push_record(&q, src, 0);
+        err_1 = msgq_push_record(&q, src, 8);
+        err_2 = msgq_push_record(&q, src, 7);
+
+        //assert
+        TEST_ASSERT_EQUAL(MSGQ_LEN_BOUNDS, err_0);
+        TEST_ASSERT_EQUAL(MSGQ_LEN_BOUNDS, err_1);
+        TEST_ASSERT_EQUAL(MSGQ_SUCCESS, err_2);
+        TEST_ASSERT_TRUE(deque_is_full(q.dq));
+}
+
+void test_msgq_pop_into_short_buffer_keeps_record(void) {
+        //arrange
+        struct msgq q;
+        uint8_t err;
+        uint8_t n;
+        unsigned char src[5] = {1, 2, 3, 4, 5};
+        unsigned char dst[5];
+        unsigned char buf[8];
+
+        //act
+        msgq_new(&q, buf, sizeof(buf));
+        msgq_push_record(&q, src, sizeof(src));
+        err = msgq_pop_record(&q, dst, 4, &n);
+
+        //assert
+        TEST_ASSERT_EQUAL(MSGQ_LEN_BOUNDS, err);
+        TEST_ASSERT_EQUAL_UINT8(5, n);
+        TEST_ASSERT_EQUAL_UINT8(5, msgq_front_len(q));
+
+        err = msgq_pop_record(&q, dst, sizeof(dst), &n);
+        TEST_ASSERT_EQUAL(MSGQ_SUCCESS, err);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(src, dst, sizeof(src));
+}
+
+void test_msgq_pop_on_empty_queue_returns_error(void) {
+        //arrange
+        struct msgq q;
+        uint8_t err;
+        uint8_t n;
+        unsigned char dst[4];
+        unsigned char buf[8];
+
+        //act
+        msgq_new(&q, buf, sizeof(buf));
+        err = msgq_pop_record(&q, dst, sizeof(dst), &n);
+
+        //assert
+        TEST_ASSERT_EQUAL(MSGQ_EMPTY, err);
+}
+
+void test_msgq_records_wrap_around_base_array(void) {
+        //arrange
+        struct msgq q;
+        uint8_t err;
+        uint8_t n;
+        unsigned char src[4];
+        unsigned char dst[4];
+        unsigned char buf[7];
+
+        //act-assert
+        msgq_new(&q, buf, sizeof(buf));
+
+        for (uint8_t i = 0; i < 50; i++) {
+                for (uint8_t j = 0; j < 4; j++) {
+                        src[j] = (unsigned char) (i + j);
+                }
+
+                err = msgq_push_record(&q, src, (uint8_t) (i % 4 + 1));
+                TEST_ASSERT_EQUAL(MSGQ_SUCCESS, err);
+
+                err = msgq_pop_record(&q, dst, sizeof(dst), &n);
+                TEST_ASSERT_EQUAL(MSGQ_SUCCESS, err);
+                TEST_ASSERT_EQUAL_UINT8(i % 4 + 1, n);
+                TEST_ASSERT_EQUAL_UINT8_ARRAY(src, dst, n);
+        }
+}
+
+int main(void)
+{
+        UNITY_BEGIN();
+
+        //initialization tests
+        RUN_TEST(test_new_msgq_capacity_below_two_returns_error);
+        RUN_TEST(test_new_msgq_null_buffer_returns_error);
+        RUN_TEST(test_new_msgq_with_legal_parameters_returns_success);
+
+        //record operations
+        RUN_TEST(test_msgq_records_keep_boundaries_and_order);
+        RUN_TEST(test_msgq_push_without_room_for_whole_record_returns_error);
+        RUN_TEST(test_msgq_push_record_length_out_of_bounds_returns_error);
+        RUN_TEST(test_msgq_pop_into_short_buffer_keeps_record);
+        RUN_TEST(test_msgq_pop_on_empty_queue_returns_error);
+        RUN_TEST(test_msgq_records_wrap_around_base_array);
+
+        return UNITY_END();
+}
@@ -0,0 +1,192 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Unit tests for fixed block pool allocator
+*/
+
+#include <stdint.h>
+
+#include "deque.h"
+#include "pool.h"
+#include "unity.h"
+
+void test_new_pool_zero_block_size_or_count_returns_error(void) {
+        //arrange
+        struct pool p;
+        uint8_t err_0;
+        uint8_t err_1;
+        unsigned char region[16];
+
+        //act
+        err_0 = pool_new(&p, region, 0, 4);
+        err_1 = pool_new(&p, region, 4, 0);
+
+        //assert
+        TEST_ASSERT_EQUAL(POOL_CAP_BOUNDS, err_0);
+        TEST_ASSERT_EQUAL(POOL_CAP_BOUNDS, err_1);
+}
+
+void test_new_pool_null_region_returns_error(void) {
+        //arrange
+        struct pool p;
+        uint8_t err;
+
+        //act
+        err = pool_new(&p, NULL, 4, 4);
+
+        //assert
+        TEST_ASSERT_EQUAL(POOL_NULL_INPUT, err);
+}
+
+void test_pool_acquire_hands_out_distinct_blocks_until_exhausted(void) {
+        //arrange
+        struct pool p;
+        uint8_t err;
+        unsigned char *block[4];
+        unsigned char *extra;
+        unsigned char region[4 * 3];
+
+        //act
+        pool_new(&p, region, 3, 4);
+
+        for (uint8_t i = 0; i < 4; i++) {
+                err = pool_acquire(&p, &block[i]);
+                TEST_ASSERT_EQUAL(POOL_SUCCESS, err);
+        }
+
+        err = pool_acquire(&p, &extra);
+
+        //assert
+        TEST_ASSERT_EQUAL(POOL_EXHAUSTED, err);
+        TEST_ASSERT_TRUE(pool_is_exhausted(p));
+        TEST_ASSERT_EQUAL_UINT8(4, pool_used(p));
+
+        for (uint8_t i = 0; i < 4; i++) {
+                TEST_ASSERT_TRUE(block[i] >= region);
+                TEST_ASSERT_TRUE(block[i] + 3 <= region + sizeof(region));
+
+                for (uint8_t j = 0; j < i; j++) {
+                        TEST_ASSERT_TRUE(block[i] != block[j]);
+                }
+        }
+}
+
+void test_pool_release_makes_block_available_again(void) {
+        //arrange
+        struct pool p;
+        uint8_t err;
+        unsigned char *block_0;
+        unsigned char *block_1;
+        unsigned char *block_2;
+        unsigned char region[2 * 8];
+
+        //act
+        pool_new(&p, region, 8, 2);
+        pool_acquire(&p, &block_0);
+        pool_acquire(&p, &block_1);
+        err = pool_release(&p, block_0);
+        pool_acquire(&p, &block_2);
+
+        //assert
+        TEST_ASSERT_EQUAL(POOL_SUCCESS, err);
+        TEST_ASSERT_EQUAL_PTR(block_0, block_2);
+        TEST_ASSERT_EQUAL_UINT8(2, pool_used(p));
+}
+
+void test_pool_high_water_mark_survives_release(void) {
+        //arrange
+        struct pool p;
+        unsigned char *block[3];
+        unsigned char region[5 * 4];
+
+        //act
+        pool_new(&p, region, 4, 5);
+
+        for (uint8_t i = 0; i < 3; i++) {
+                pool_acquire(&p, &block[i]);
+        }
+
+        for (uint8_t i = 0; i < 3; i++) {
+                pool_release(&p, block[i]);
+        }
+
+        pool_acquire(&p, &block[0]);
+
+        //assert
+        TEST_ASSERT_EQUAL_UINT8(1, pool_used(p));
+        TEST_ASSERT_EQUAL_UINT8(3, pool_hwm(p));
+}
+
+void test_pool_release_foreign_pointer_returns_error(void) {
+        //arrange
+        struct pool p;
+        uint8_t err_0;
+        uint8_t err_1;
+        uint8_t err_2;
+        unsigned char *block;
+        unsigned char region[4 * 4];
+
+        //act
+        pool_new(&p, region, 4, 4);
+        pool_acquire(&p, &block);
+        err_0 = pool_release(&p, block + 1);
+        err_1 = pool_release(&p, region + sizeof(region));
+        err_2 = pool_release(&p, block);
+
+        //assert
+        TEST_ASSERT_EQUAL(POOL_BAD_BLOCK, err_0);
+        TEST_ASSERT_EQUAL(POOL_BAD_BLOCK, err_1);
+        TEST_ASSERT_EQUAL(POOL_SUCCESS, err_2);
+        TEST_ASSERT_EQUAL(POOL_BAD_BLOCK, pool_release(&p, block));
+}
+
+void test_pool_blocks_back_independent_deques(void) {
+        //arrange
+        struct pool p;
+        struct deque dq[3];
+        unsigned char *buf;
+        unsigned char data;
+        unsigned char region[3 * 16];
+
+        //act
+        pool_new(&p, region, 16, 3);
+
+        for (uint8_t i = 0; i < 3; i++) {
+                pool_acquire(&p, &buf);
+                deque_new(&dq[i], buf, pool_block_size(p));
+
+                for (uint8_t j = 0; j < 16; j++) {
+                        deque_push_back(&dq[i], (unsigned char) (i * 16 + j));
+                }
+        }
+
+        //assert
+        for (uint8_t i = 0; i < 3; i++) {
+                for (uint8_t j = 0; j < 16; j++) {
+                        deque_pop_front(&dq[i], &data);
+                        TEST_ASSERT_EQUAL_UINT8(i * 16 + j, data);
+                }
+
+                TEST_ASSERT_EQUAL(POOL_SUCCESS, pool_release(&p, dq[i].buf));
+        }
+
+        TEST_ASSERT_EQUAL_UINT8(0, pool_used(p));
+}
+
+int main(void)
+{
+        UNITY_BEGIN();
+
+        //initialization tests
+        RUN_TEST(test_new_pool_zero_block_size_or_count_returns_error);
+        RUN_TEST(test_new_pool_null_region_returns_error);
+
+        //acquire and release
+        RUN_TEST(test_pool_acquire_hands_out_distinct_blocks_until_exhausted);
+        RUN_TEST(test_pool_release_makes_block_available_again);
+        RUN_TEST(test_pool_high_water_mark_survives_release);
+        RUN_TEST(test_pool_release_foreign_pointer_returns_error);
+        RUN_TEST(test_pool_blocks_back_independent_deques);
+
+        return UNITY_END();
+}
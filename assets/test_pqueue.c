@@ -0,0 +1,199 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Unit tests for binary min-heap priority queue. The same suite runs with 32-bit
+* keys in the test_pqueue32 build.
+*/
+
+#include <stdint.h>
+
+#include "pqueue.h"
+#include "unity.h"
+
+#ifdef PQUEUE_KEY32
+        #define KEY_MAX UINT32_MAX
+#else
+        #define KEY_MAX UINT16_MAX
+#endif
+
+void test_new_pqueue_zero_capacity_returns_error(void) {
+        //arrange
+        struct pqueue pq;
+        uint8_t err;
+        struct pqueue_entry heap[4];
+
+        //act
+        err = pqueue_new(&pq, heap, 0);
+
+        //assert
+        TEST_ASSERT_EQUAL(PQUEUE_CAP_BOUNDS, err);
+}
+
+void test_new_pqueue_null_base_array_returns_error(void) {
+        //arrange
+        struct pqueue pq;
+        uint8_t err;
+
+        //act
+        err = pqueue_new(&pq, NULL, 4);
+
+        //assert
+        TEST_ASSERT_EQUAL(PQUEUE_NULL_INPUT, err);
+}
+
+void test_pqueue_push_on_full_heap_returns_error(void) {
+        //arrange
+        struct pqueue pq;
+        uint8_t err;
+        struct pqueue_entry heap[2];
+
+        //act
+        pqueue_new(&pq, heap, 2);
+        pqueue_push(&pq, 10, 0);
+        pqueue_push(&pq, 20, 1);
+        err = pqueue_push(&pq, 5, 2);
+
+        //assert
+        TEST_ASSERT_EQUAL(PQUEUE_FULL, err);
+        TEST_ASSERT_EQUAL(10, pqueue_peek_key(pq));
+}
+
+void test_pqueue_pop_on_empty_heap_returns_error(void) {
+        //arrange
+        struct pqueue pq;
+        uint8_t err;
+        uint8_t value;
+        struct pqueue_entry heap[2];
+
+        //act
+        pqueue_new(&pq, heap, 2);
+        pqueue_push(&pq, 10, 0);
+        pqueue_pop(&pq, NULL, &value);
+        err = pqueue_pop(&pq, NULL, &value);
+
+        //assert
+        TEST_ASSERT_EQUAL(PQUEUE_EMPTY, err);
+}
+
+void test_pqueue_pops_in_key_order(void) {
+        //arrange
+        struct pqueue pq;
+        uint8_t err;
+        pqueue_key key;
+        pqueue_key prev = 0;
+        uint8_t value;
+        uint16_t lcg = 12345;
+        struct pqueue_entry heap[255];
+
+        //act
+        pqueue_new(&pq, heap, 255);
+
+        for (uint8_t i = 0; i < 255; i++) {
+                lcg = (uint16_t) (lcg * 25173U + 13849U);
+                err = pqueue_push(&pq, (pqueue_key) (lcg & 0x3FFF), i);
+                TEST_ASSERT_EQUAL(PQUEUE_SUCCESS, err);
+        }
+
+        //assert
+        TEST_ASSERT_TRUE(pqueue_is_full(pq));
+
+        for (uint8_t i = 0; i < 255; i++) {
+                err = pqueue_pop(&pq, &key, &value);
+                TEST_ASSERT_EQUAL(PQUEUE_SUCCESS, err);
+                TEST_ASSERT_TRUE(key >= prev);
+                prev = key;
+        }
+
+        TEST_ASSERT_TRUE(pqueue_is_empty(pq));
+}
+
+void test_pqueue_value_travels_with_key(void) {
+        //arrange
+        struct pqueue pq;
+        pqueue_key key;
+        uint8_t value;
+        struct pqueue_entry heap[4];
+
+        //act
+        pqueue_new(&pq, heap, 4);
+        pqueue_push(&pq, 300, 'c');
+        pqueue_push(&pq, 100, 'a');
+        pqueue_push(&pq, 400, 'd');
+        pqueue_push(&pq, 200, 'b');
+
+        //assert
+        for (uint8_t i = 0; i < 4; i++) {
+                pqueue_pop(&pq, &key, &value);
+                TEST_ASSERT_EQUAL(100 * (i + 1), key);
+                TEST_ASSERT_EQUAL_UINT8('a' + i, value);
+        }
+}
+
+void test_pqueue_deadlines_across_counter_wrap(void) {
+        //arrange
+        struct pqueue pq;
+        pqueue_key key;
+        uint8_t value;
+        struct pqueue_entry heap[4];
+
+        //act
+        pqueue_new(&pq, heap, 4);
+        pqueue_push(&pq, 5, 2);
+        pqueue_push(&pq, (pqueue_key) (KEY_MAX - 4), 0);
+        pqueue_push(&pq, 20, 3);
+        pqueue_push(&pq, KEY_MAX, 1);
+
+        //assert
+        for (uint8_t i = 0; i < 4; i++) {
+                pqueue_pop(&pq, &key, &value);
+                TEST_ASSERT_EQUAL_UINT8(i, value);
+        }
+}
+
+void test_pqueue_interleaved_push_and_pop(void) {
+        //arrange
+        struct pqueue pq;
+        pqueue_key key;
+        uint8_t value;
+        struct pqueue_entry heap[8];
+
+        //act-assert
+        pqueue_new(&pq, heap, 8);
+        pqueue_push(&pq, 50, 0);
+        pqueue_push(&pq, 30, 0);
+        pqueue_push(&pq, 40, 0);
+
+        pqueue_pop(&pq, &key, &value);
+        TEST_ASSERT_EQUAL(30, key);
+
+        pqueue_push(&pq, 10, 0);
+        pqueue_push(&pq, 45, 0);
+
+        pqueue_pop(&pq, &key, &value);
+        TEST_ASSERT_EQUAL(10, key);
+        pqueue_pop(&pq, &key, &value);
+        TEST_ASSERT_EQUAL(40, key);
+        pqueue_pop(&pq, &key, &value);
+        TEST_ASSERT_EQUAL(45, key);
+        pqueue_pop(&pq, &key, &value);
+        TEST_ASSERT_EQUAL(50, key);
+}
+
+int main(void)
+{
+        UNITY_BEGIN();
+
+        //initialization tests
+        RUN_TEST(test_new_pqueue_zero_capacity_returns_error);
+        RUN_TEST(test_new_pqueue_null_base_array_returns_error);
+
+        //heap operations
+        RUN_TEST(test_pqueue_push_on_full_heap_returns_error);
+        RUN_TEST(test_pqueue_pop_on_empty_heap_returns_error);
+        RUN_TEST(test_pqueue_pops_in_key_order);
+        RUN_TEST(test_pqueue_value_travels_with_key);
+        RUN_TEST(test_pqueue_deadlines_across_counter_wrap);
+        RUN_TEST(test_pqueue_interleaved_push_and_pop);
+
+        return UNITY_END();
+}
@@ -0,0 +1,209 @@
+/*
+* Copyright (C) 2021 Biren Patel
+* MIT License
+* Unit tests for single producer single consumer ring
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+
+#include "spsc.h"
+#include "unity.h"
+
+void test_new_spsc_zero_capacity_returns_error(void) {
+        //arrange
+        struct spsc q;
+        uint8_t err;
+        unsigned char buf[4];
+
+        //act
+        err = spsc_new(&q, buf, 0);
+
+        //assert
+        TEST_ASSERT_EQUAL(SPSC_CAP_BOUNDS, err);
+}
+
+void test_new_spsc_non_power_of_two_capacity_returns_error(void) {
+        //arrange
+        struct spsc q;
+        uint8_t err;
+        unsigned char buf[255];
+
+        //act
+        err = spsc_new(&q, buf, 255);
+
+        //assert
+        TEST_ASSERT_EQUAL(SPSC_CAP_BOUNDS, err);
+}
+
+void test_new_spsc_null_buffer_returns_error(void) {
+        //arrange
+        struct spsc q;
+        uint8_t err;
+
+        //act
+        err = spsc_new(&q, NULL, 4);
+
+        //assert
+        TEST_ASSERT_EQUAL(SPSC_NULL_INPUT, err);
+}
+
+void test_new_spsc_with_legal_parameters_returns_success(void) {
+        //arrange
+        struct spsc q;
+        uint8_t err;
+        unsigned char buf[128];
+
+        //act
+        err = spsc_new(&q, buf, sizeof(buf));
+
+        //assert
+        TEST_ASSERT_EQUAL(SPSC_SUCCESS, err);
+        TEST_ASSERT_TRUE(spsc_is_empty(q));
+}
+
+void test_spsc_push_on_full_ring_returns_error(void) {
+        //arrange
+        struct spsc q;
+        uint8_t err;
+        unsigned char buf[4];
+
+        //act
+        spsc_new(&q, buf, sizeof(buf));
+
+        for (uint8_t i = 0; i < 4; i++) {
+                spsc_push(&q, i);
+        }
+
+        err = spsc_push(&q, 42);
+
+        //assert
+        TEST_ASSERT_EQUAL(SPSC_FULL, err);
+        TEST_ASSERT_TRUE(spsc_is_full(q));
+}
+
+void test_spsc_pop_on_empty_ring_returns_error(void) {
+        //arrange
+        struct spsc q;
+        uint8_t err;
+        unsigned char data;
+        unsigned char buf[4];
+
+        //act
+        spsc_new(&q, buf, sizeof(buf));
+        spsc_push(&q, 42);
+        spsc_pop(&q, &data);
+        err = spsc_pop(&q, &data);
+
+        //assert
+        TEST_ASSERT_EQUAL(SPSC_EMPTY, err);
+}
+
+void test_spsc_fifo_order_across_index_overflow(void) {
+        //arrange
+        struct spsc q;
+        int err;
+        unsigned char data;
+        unsigned char buf[128];
+
+        //act
+        spsc_new(&q, buf, sizeof(buf));
+
+        //act-assert
+        for (uint16_t n = 0; n < 1000; n++) {
+                for (uint8_t i = 0; i < 100; i++) {
+                        err = spsc_push(&q, (unsigned char) (n + i));
+                        TEST_ASSERT_EQUAL(err, SPSC_SUCCESS);
+                }
+
+                TEST_ASSERT_EQUAL_UINT8(100, spsc_len(q));
+
+                for (uint8_t i = 0; i < 100; i++) {
+                        err = spsc_pop(&q, &data);
+                        TEST_ASSERT_EQUAL(err, SPSC_SUCCESS);
+                        TEST_ASSERT_EQUAL_UINT8((unsigned char) (n + i), data);
+                }
+        }
+}
+
+/*******************************************************************************
+* stress test. The producer and consumer run on separate threads with a small
+* ring so that both the full and empty conditions are hit constantly. Every
+* byte of a known sequence must arrive exactly once and in order. The spin loops
+* yield so that the test still completes quickly on a single core host.
+*/
+
+#define STRESS_COUNT 1000000UL
+
+static struct spsc stress_q;
+static unsigned char stress_buf[8];
+
+static void *stress_producer(void *arg) {
+        (void) arg;
+
+        for (unsigned long i = 0; i < STRESS_COUNT; i++) {
+                while (spsc_push(&stress_q, (unsigned char) i) == SPSC_FULL) {
+                        sched_yield();
+                }
+        }
+
+        return NULL;
+}
+
+static void *stress_consumer(void *arg) {
+        unsigned long *errors = arg;
+        unsigned char data;
+
+        for (unsigned long i = 0; i < STRESS_COUNT; i++) {
+                while (spsc_pop(&stress_q, &data) == SPSC_EMPTY) {
+                        sched_yield();
+                }
+
+                if (data != (unsigned char) i) {
+                        (*errors)++;
+                }
+        }
+
+        return NULL;
+}
+
+void test_spsc_two_thread_stress(void) {
+        //arrange
+        pthread_t producer;
+        pthread_t consumer;
+        unsigned long errors = 0;
+
+        spsc_new(&stress_q, stress_buf, sizeof(stress_buf));
+
+        //act
+        pthread_create(&consumer, NULL, stress_consumer, &errors);
+        pthread_create(&producer, NULL, stress_producer, NULL);
+        pthread_join(producer, NULL);
+        pthread_join(consumer, NULL);
+
+        //assert
+        TEST_ASSERT_EQUAL_UINT32(0, errors);
+        TEST_ASSERT_TRUE(spsc_is_empty(stress_q));
+}
+
+int main(void)
+{
+        UNITY_BEGIN();
+
+        //initialization tests
+        RUN_TEST(test_new_spsc_zero_capacity_returns_error);
+        RUN_TEST(test_new_spsc_non_power_of_two_capacity_returns_error);
+        RUN_TEST(test_new_spsc_null_buffer_returns_error);
+        RUN_TEST(test_new_spsc_with_legal_parameters_returns_success);
+
+        //single thread
+        RUN_TEST(test_spsc_push_on_full_ring_returns_error);
+        RUN_TEST(test_spsc_pop_on_empty_ring_returns_error);
+        RUN_TEST(test_spsc_fifo_order_across_index_overflow);
+
+        //two threads
+        RUN_TEST(test_spsc_two_thread_stress);
+
+        return UNITY_END();
+}
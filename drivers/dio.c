@@ -107,7 +107,7 @@ uint8_t dio_open(const dio_config *const table, const uint8_t n)
 
                 atomic {
                         open_err = dio_open_entry(entry.pin, entry.mode);
-                        write_err = dio_write(entry.pin, entry.value);
+                        write_err = dio_write_table(entry.pin, entry.value);
                 }
 
                 if (open_err) {
@@ -151,9 +151,16 @@ static uint8_t dio_open_entry(const uint8_t pin, const uint8_t mode)
         return DIO_SUCCESS;
 }
 
-/******************************************************************************/
+/*******************************************************************************
+The register address comes from the lookup table at runtime, so the compiler
+cannot emit sbi/cbi here and LOW/HIGH are a load, modify and store on PORTx. An
+ISR that writes the same port between the load and the store would have its
+update lost, so those two cases run with interrupts masked. TOGGLE needs no
+masking: writing a 1 to a PINx bit flips the PORTx bit in hardware and leaves
+the other bits alone, so it is a single store.
+*/
 
-uint8_t dio_write(const uint8_t pin, const uint8_t value)
+uint8_t dio_write_table(const uint8_t pin, const uint8_t value)
 {
         if (pin > DIO_D7) {
                 return DIO_ERR_PIN;
@@ -166,15 +173,19 @@ uint8_t dio_write(const uint8_t pin, const uint8_t value)
 
         switch (value) {
                 case LOW:
-                        *port_reg &= ~(attr.mask);
+                        atomic {
+                                *port_reg &= ~(attr.mask);
+                        }
                         break;
 
                 case HIGH: /* PULLUP on INPUT */
-                        *port_reg |= attr.mask;
+                        atomic {
+                                *port_reg |= attr.mask;
+                        }
                         break;
 
                 case TOGGLE:
-                        *port_reg ^= attr.mask;
+                        *attr.pin_reg = attr.mask;
                         break;
 
                 default:
@@ -199,3 +210,186 @@ uint8_t dio_read(const uint8_t pin, uint8_t *const value)
 
         return DIO_SUCCESS;
 }
+
+/*******************************************************************************
+Port C has no bit 7, so port D starts at bit 15 of the snapshot to line up with
+DIO_D0. The three PIN reads are only a few cycles apart, but an ISR between them
+could still change outputs on a later port, hence the atomic block.
+*/
+
+uint32_t dio_read_all(void)
+{
+        uint8_t b;
+        uint8_t c;
+        uint8_t d;
+
+        atomic {
+                b = PINB;
+                c = PINC;
+                d = PIND;
+        }
+
+        return (uint32_t) b
+               | ((uint32_t) (c & 0x7F) << DIO_C0)
+               | ((uint32_t) d << DIO_D0);
+}
+
+/******************************************************************************/
+
+uint8_t dio_read_many(const uint8_t *const pins, const uint8_t n,
+                      uint8_t *const values)
+{
+        if (!pins || !values) {
+                return DIO_ERR_NULL;
+        }
+
+        if (n == 0) {
+                return DIO_ERR_VALUE;
+        }
+
+        for (uint8_t i = 0; i < n; i++) {
+                if (pins[i] > DIO_D7) {
+                        return DIO_ERR_PIN;
+                }
+        }
+
+        const uint32_t snapshot = dio_read_all();
+
+        for (uint8_t i = 0; i < n; i++) {
+                values[i] = dio_snapshot_bit(snapshot, pins[i]);
+        }
+
+        return DIO_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t dio_bind(const uint8_t pin, dio_handle *const handle)
+{
+        if (!handle) {
+                return DIO_ERR_NULL;
+        }
+
+        if (pin > DIO_D7) {
+                return DIO_ERR_PIN;
+        }
+
+        attributes attr = {0};
+        memcpy_P(&attr, &lookup[pin], sizeof(attributes));
+
+        handle->pin_reg = attr.pin_reg;
+        handle->mask = attr.mask;
+
+        return DIO_SUCCESS;
+}
+
+/*******************************************************************************
+The writes are folded into three masks per port and then applied as
+PORT = ((PORT & ~clr) | set) ^ tgl. A later entry for the same pin cancels the
+earlier ones, except that TOGGLE composes with whatever came before it, which
+gives the same result as applying the entries one at a time. A port with only
+toggles is written as a single store of tgl to its PIN register, which needs no
+interrupt masking. A port that also has sets or clears keeps the toggles in its
+masked read-modify-write so that every pin still changes on the same edge.
+*/
+
+uint8_t dio_write_many(const dio_value *const table, const uint8_t n)
+{
+        if (!table) {
+                return DIO_ERR_NULL;
+        }
+
+        if (n == 0) {
+                return DIO_ERR_VALUE;
+        }
+
+        uint8_t set[3] = {0};
+        uint8_t clr[3] = {0};
+        uint8_t tgl[3] = {0};
+
+        for (uint8_t i = 0; i < n; i++) {
+                const uint8_t pin = table[i].pin;
+
+                if (pin > DIO_D7) {
+                        return DIO_ERR_PIN;
+                }
+
+                const uint8_t port = DIO_PORT_OF(pin);
+                const uint8_t mask = 1 << DIO_BIT_OF(pin);
+
+                switch (table[i].value) {
+                        case LOW:
+                                clr[port] |= mask;
+                                set[port] &= ~mask;
+                                tgl[port] &= ~mask;
+                                break;
+
+                        case HIGH: /* PULLUP on INPUT */
+                                set[port] |= mask;
+                                clr[port] &= ~mask;
+                                tgl[port] &= ~mask;
+                                break;
+
+                        case TOGGLE:
+                                tgl[port] ^= mask;
+                                break;
+
+                        default:
+                                return DIO_ERR_VALUE;
+                }
+        }
+
+        for (uint8_t port = DIO_PORTB; port <= DIO_PORTD; port++) {
+                if (!(set[port] | clr[port])) {
+                        if (tgl[port]) {
+                                *DIO_PIN_REG(port) = tgl[port];
+                        }
+
+                        continue;
+                }
+
+                volatile uint8_t *const port_reg = DIO_PORT_REG(port);
+
+                atomic {
+                        *port_reg = ((*port_reg & ~clr[port]) | set[port])
+                                    ^ tgl[port];
+                }
+        }
+
+        return DIO_SUCCESS;
+}
+
+/******************************************************************************/
+
+uint8_t dio_write_mask(const uint8_t port, const uint8_t mask,
+                       const uint8_t value)
+{
+        if (port > DIO_PORTD || (port == DIO_PORTC && (mask & 0x80))) {
+                return DIO_ERR_PIN;
+        }
+
+        volatile uint8_t *const port_reg = DIO_PORT_REG(port);
+
+        switch (value) {
+                case LOW:
+                        atomic {
+                                *port_reg &= ~mask;
+                        }
+                        break;
+
+                case HIGH: /* PULLUP on INPUT */
+                        atomic {
+                                *port_reg |= mask;
+                        }
+                        break;
+
+                case TOGGLE:
+                        *DIO_PIN_REG(port) = mask;
+                        break;
+
+                default:
+                        return DIO_ERR_VALUE;
+        }
+
+        return DIO_SUCCESS;
+}
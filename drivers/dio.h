@@ -8,6 +8,11 @@
 #ifndef DIO_H
 #define DIO_H
 
+#include <stdint.h>
+
+#include <avr/io.h>
+#include <util/atomic.h>
+
 /* error codes */
 #define DIO_SUCCESS     (uint8_t) 0 /**< @brief Function was successful.      */
 #define DIO_ERR_PIN     (uint8_t) 1 /**< @brief Input pin is invalid.         */
@@ -23,6 +28,11 @@
 #define PULLUP  (uint8_t) 1
 #define TOGGLE  (uint8_t) 2
 
+/* digital I/O ports for the multi-pin API, see dio_write_mask() */
+#define DIO_PORTB (uint8_t) 0
+#define DIO_PORTC (uint8_t) 1
+#define DIO_PORTD (uint8_t) 2
+
 /* digital I/O pins for the ATmega328P SPDIP pin configuration */
 #define DIO_B0 (uint8_t) 0
 #define DIO_B1 (uint8_t) 1
@@ -48,6 +58,23 @@
 #define DIO_D6 (uint8_t) 21
 #define DIO_D7 (uint8_t) 22
 
+/*******************************************************************************
+* @brief Port and bit of a DIO_xx pin.
+* @details The DIO_xx numbers run through ports B, C and D in order, and the PIN
+* registers of the three ports are 3 addresses apart with DDR = PIN + 1 and
+* PORT = PIN + 2. A constant pin therefore resolves to a constant register
+* address and bit at compile time, without the flash lookup table in dio.c.
+*******************************************************************************/
+#define DIO_PORT_OF(pin) \
+        ((pin) < DIO_C0 ? DIO_PORTB : (pin) < DIO_D0 ? DIO_PORTC : DIO_PORTD)
+#define DIO_BIT_OF(pin) \
+        ((pin) < DIO_C0 ? (pin) - DIO_B0 \
+                        : (pin) < DIO_D0 ? (pin) - DIO_C0 : (pin) - DIO_D0)
+
+#define DIO_PIN_REG(port) (&PINB + 3 * (port))
+#define DIO_DDR_REG(port) (DIO_PIN_REG(port) + 1)
+#define DIO_PORT_REG(port) (DIO_PIN_REG(port) + 2)
+
 /* pin map for SPDIP physical layout */
 #define PIN01 DIO_C6
 #define PIN02 DIO_D0
@@ -112,6 +139,32 @@ typedef struct dio_config {
         uint8_t value;
 } dio_config;
 
+/*******************************************************************************
+* @struct dio_value
+* @brief Pin and value pair for batched writes.
+* @var dio_value::pin
+*       @brief Selected from the Px, PINx, or ARDUINOx macros
+* @var dio_value::value
+*       @brief LOW, HIGH, TOGGLE, or PULLUP
+*******************************************************************************/
+typedef struct dio_value {
+        uint8_t pin;
+        uint8_t value;
+} dio_value;
+
+/*******************************************************************************
+* @struct dio_handle
+* @brief Pre-resolved register details of one pin, filled in by dio_bind().
+* @var dio_handle::pin_reg
+*       @brief pointer to the associated PIN register
+* @var dio_handle::mask
+*       @brief bitmask over the PIN register. e.g., 1 << PINC3
+*******************************************************************************/
+typedef struct dio_handle {
+        volatile uint8_t *pin_reg;
+        uint8_t mask;
+} dio_handle;
+
 /*******************************************************************************
 * @function dio_open
 * @brief Configure pins for input or output and with an initial value
@@ -120,13 +173,54 @@ typedef struct dio_config {
 *******************************************************************************/
 uint8_t dio_open(const dio_config *const table, const uint8_t n);
 
+/*******************************************************************************
+* @function dio_write_table
+* @brief Runtime path of dio_write() through the flash lookup table.
+* @details TOGGLE is a single store to the PIN register. LOW and HIGH are a
+* read-modify-write of the PORT register with interrupts masked.
+* @param[in] pin
+* @param[in] value One of HIGH, LOW, TOGGLE, or PULLUP
+*******************************************************************************/
+uint8_t dio_write_table(const uint8_t pin, const uint8_t value);
+
 /*******************************************************************************
 * @function dio_write
 * @brief Drive an output pin or configure the pullup resistor on an input pin.
+* @details When both arguments are compile-time constants and valid, the write
+* is resolved here at compile time: sbi or cbi on the PORT register for HIGH and
+* LOW, and an ldi/out of the bit to the PIN register for TOGGLE, which flips the
+* PORT bit in hardware. Each is a single atomic register write. Any other call
+* falls back to dio_write_table(), which is also safe against an ISR writing the
+* same port, so callers never need an ATOMIC_BLOCK around a write. Requires
+* optimization (-O1 or above) so that the constant arguments are visible after
+* inlining.
 * @param[in] pin
 * @param[in] value One of HIGH, LOW, TOGGLE, or PULLUP
 *******************************************************************************/
-uint8_t dio_write(const uint8_t pin, const uint8_t value);
+static inline __attribute__((always_inline))
+uint8_t dio_write(const uint8_t pin, const uint8_t value)
+{
+        if (__builtin_constant_p(pin) && __builtin_constant_p(value)
+            && pin <= DIO_D7) {
+                const uint8_t mask = 1 << DIO_BIT_OF(pin);
+
+                switch (value) {
+                        case LOW:
+                                *DIO_PORT_REG(DIO_PORT_OF(pin)) &= ~mask;
+                                return DIO_SUCCESS;
+
+                        case HIGH: /* PULLUP on INPUT */
+                                *DIO_PORT_REG(DIO_PORT_OF(pin)) |= mask;
+                                return DIO_SUCCESS;
+
+                        case TOGGLE:
+                                *DIO_PIN_REG(DIO_PORT_OF(pin)) = mask;
+                                return DIO_SUCCESS;
+                }
+        }
+
+        return dio_write_table(pin, value);
+}
 
 /*******************************************************************************
 * @function dio_read
@@ -136,4 +230,110 @@ uint8_t dio_write(const uint8_t pin, const uint8_t value);
 *******************************************************************************/
 uint8_t dio_read(const uint8_t pin, uint8_t *const value);
 
+/*******************************************************************************
+* @function dio_bind
+* @brief Validate a pin once and resolve it into a handle for the _h functions.
+* @param[in] pin
+* @param[out] handle
+*******************************************************************************/
+uint8_t dio_bind(const uint8_t pin, dio_handle *const handle);
+
+/*******************************************************************************
+* @function dio_write_h
+* @brief dio_write() through a handle from dio_bind().
+* @details No argument is checked and the flash lookup table is not read, so
+* the cost is a few loads and one register write. TOGGLE is a single store to
+* the PIN register. LOW and HIGH are a read-modify-write of the PORT register
+* with interrupts masked. Any other value is ignored.
+* @param[in] handle
+* @param[in] value One of HIGH, LOW, TOGGLE, or PULLUP
+*******************************************************************************/
+static inline void dio_write_h(const dio_handle *const handle,
+                               const uint8_t value)
+{
+        volatile uint8_t *const port_reg = handle->pin_reg + 2;
+
+        switch (value) {
+                case LOW:
+                        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+                                *port_reg &= ~(handle->mask);
+                        }
+                        break;
+
+                case HIGH: /* PULLUP on INPUT */
+                        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+                                *port_reg |= handle->mask;
+                        }
+                        break;
+
+                case TOGGLE:
+                        *handle->pin_reg = handle->mask;
+                        break;
+        }
+}
+
+/*******************************************************************************
+* @function dio_read_h
+* @brief dio_read() through a handle from dio_bind(), without any checks.
+* @param[in] handle
+* @return HIGH or LOW
+*******************************************************************************/
+static inline uint8_t dio_read_h(const dio_handle *const handle)
+{
+        return (*handle->pin_reg & handle->mask) ? HIGH : LOW;
+}
+
+/*******************************************************************************
+* @function dio_read_all
+* @brief Sample every pin of ports B, C and D in one coherent snapshot.
+* @details PINB, PINC and PIND are read back to back with interrupts masked.
+* Bit n of the result is the level of pin DIO_xx == n, so one snapshot can be
+* tested with dio_snapshot_bit() for any number of pins.
+* @return 23-bit bitmap indexed by the DIO_xx numbering
+*******************************************************************************/
+uint32_t dio_read_all(void);
+
+/* level of a DIO_xx pin in a dio_read_all() snapshot, HIGH or LOW */
+#define dio_snapshot_bit(snapshot, pin) (uint8_t) (((snapshot) >> (pin)) & 0x1)
+
+/*******************************************************************************
+* @function dio_read_many
+* @brief Read a list of pins from a single dio_read_all() snapshot.
+* @details The list is validated in full before the ports are sampled, so on
+* error no value is written.
+* @param[in] pins Selected from the Px, PINx, or ARDUINOx macros
+* @param[in] n total elements in pins
+* @param[out] values Either HIGH or LOW per pin on successful return
+*******************************************************************************/
+uint8_t dio_read_many(const uint8_t *const pins, const uint8_t n,
+                      uint8_t *const values);
+
+/*******************************************************************************
+* @function dio_write_many
+* @brief Apply a table of writes with one port register update per port.
+* @details The table is validated in full before any pin changes, so on error
+* no pin is written. The writes are then merged per port and each port register
+* is updated once, so all pins on a port change on the same clock edge. A port
+* with only TOGGLE entries takes one store to its PIN register. Otherwise the
+* update is a read-modify-write with interrupts masked. Entries apply in table
+* order, e.g. HIGH then TOGGLE on the same pin leaves it LOW.
+* @param[in] table
+* @param[in] n total elements in table
+*******************************************************************************/
+uint8_t dio_write_many(const dio_value *const table, const uint8_t n);
+
+/*******************************************************************************
+* @function dio_write_mask
+* @brief Drive several pins of one port with a single register update.
+* @details TOGGLE flips every selected pin with one store to the PIN register.
+* LOW and HIGH are one read-modify-write of the PORT register with interrupts
+* masked, so a concurrent ISR update to other pins of the port is not lost.
+* @param[in] port One of DIO_PORTB, DIO_PORTC, or DIO_PORTD
+* @param[in] mask Bit n selects pin n of the port, e.g. 1 << PORTB3. Port C has
+* no bit 7.
+* @param[in] value One of HIGH, LOW, TOGGLE, or PULLUP
+*******************************************************************************/
+uint8_t dio_write_mask(const uint8_t port, const uint8_t mask,
+                       const uint8_t value);
+
 #endif /* DIO_H */